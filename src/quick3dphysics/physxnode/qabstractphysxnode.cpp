@@ -4,6 +4,7 @@
 #include "qabstractphysxnode_p.h"
 
 #include "qabstractphysicsnode_p.h"
+#include "physxnode/qphysxworld_p.h"
 #include "qphysicsmaterial_p.h"
 #include "qstaticphysxobjects_p.h"
 
@@ -54,14 +55,13 @@ void QAbstractPhysXNode::createMaterial(QPhysXWorld *physX)
     createMaterialFromQtMaterial(physX, nullptr);
 }
 
-void QAbstractPhysXNode::createMaterialFromQtMaterial(QPhysXWorld *, QPhysicsMaterial *qtMaterial)
+void QAbstractPhysXNode::createMaterialFromQtMaterial(QPhysXWorld *physX,
+                                                      QPhysicsMaterial *qtMaterial)
 {
     auto &s_physx = StaticPhysXObjects::getReference();
 
     if (qtMaterial) {
-        material = s_physx.physics->createMaterial(qtMaterial->staticFriction(),
-                                                   qtMaterial->dynamicFriction(),
-                                                   qtMaterial->restitution());
+        material = physX->materialRegistry.acquire(qtMaterial);
     } else {
         if (!sDefaultMaterial) {
             sDefaultMaterial = s_physx.physics->createMaterial(
@@ -70,20 +70,37 @@ void QAbstractPhysXNode::createMaterialFromQtMaterial(QPhysXWorld *, QPhysicsMat
         }
         material = sDefaultMaterial;
     }
+    // The material now matches the one of the frontend node
+    if (frontendNode)
+        setMaterialDirty(false);
 }
 
+void QAbstractPhysXNode::releaseMaterial(QPhysXWorld *physX, physx::PxMaterial *material)
+{
+    // The default material is shared by all nodes without a material and never released here
+    if (material && material != sDefaultMaterial)
+        physX->materialRegistry.release(material);
+}
+
+bool QAbstractPhysXNode::isSyncedEveryFrame() const
+{
+    return true;
+}
+
+void QAbstractPhysXNode::frontendChanged() { }
+
 void QAbstractPhysXNode::markDirtyShapes() { }
 
 void QAbstractPhysXNode::rebuildDirtyShapes(QPhysicsWorld *, QPhysXWorld *) { }
 
 void QAbstractPhysXNode::updateFilters() { }
 
-void QAbstractPhysXNode::cleanup(QPhysXWorld *)
+void QAbstractPhysXNode::cleanup(QPhysXWorld *physX)
 {
     for (auto *shape : shapes)
         PHYSX_RELEASE(shape);
-    if (material != sDefaultMaterial)
-        PHYSX_RELEASE(material);
+    releaseMaterial(physX, material);
+    material = nullptr;
 }
 
 bool QAbstractPhysXNode::debugGeometryCapability()
@@ -127,4 +144,21 @@ void QAbstractPhysXNode::setFiltersDirty(bool dirty)
     frontendNode->m_filtersDirty = dirty;
 }
 
+bool QAbstractPhysXNode::materialDirty() const
+{
+    return frontendNode && frontendNode->m_materialDirty;
+}
+
+void QAbstractPhysXNode::setMaterialDirty(bool dirty)
+{
+    Q_ASSERT(frontendNode);
+    frontendNode->m_materialDirty = dirty;
+}
+
+QSet<QAbstractCollisionShape *> QAbstractPhysXNode::takeDirtyCollisionShapes()
+{
+    Q_ASSERT(frontendNode);
+    return std::exchange(frontendNode->m_dirtyCollisionShapes, {});
+}
+
 QT_END_NAMESPACE
@@ -18,6 +18,7 @@
 #include "foundation/PxTransform.h"
 #include "qtconfigmacros.h"
 
+#include <QSet>
 #include <QVector>
 
 namespace physx {
@@ -27,6 +28,7 @@ class PxShape;
 
 QT_BEGIN_NAMESPACE
 
+class QAbstractCollisionShape;
 class QAbstractPhysicsNode;
 class QMatrix4x4;
 class QQuick3DNode;
@@ -65,6 +67,7 @@ public:
     virtual void updateDefaultDensity(float density);
     virtual void createMaterial(QPhysXWorld *physX);
     void createMaterialFromQtMaterial(QPhysXWorld *physX, QPhysicsMaterial *qtMaterial);
+    static void releaseMaterial(QPhysXWorld *physX, physx::PxMaterial *material);
     virtual void markDirtyShapes();
     virtual void rebuildDirtyShapes(QPhysicsWorld *, QPhysXWorld *);
     virtual void updateFilters();
@@ -77,13 +80,25 @@ public:
     virtual bool useTriggerFlag();
     virtual DebugDrawBodyType getDebugDrawBodyType();
 
+    // Backends that are not synced every frame are only synced after frontendChanged()
+    virtual bool isSyncedEveryFrame() const;
+    // Called when the shapes, the filters or the material of the frontend node changed
+    virtual void frontendChanged();
+
     bool shapesDirty() const;
     void setShapesDirty(bool dirty);
 
     bool filtersDirty() const;
     void setFiltersDirty(bool dirty);
 
+    bool materialDirty() const;
+    void setMaterialDirty(bool dirty);
+
+    QSet<QAbstractCollisionShape *> takeDirtyCollisionShapes();
+
     QVector<physx::PxShape *> shapes;
+    // The collision shape each entry in shapes was created from
+    QVector<QAbstractCollisionShape *> collisionShapes;
     physx::PxMaterial *material = nullptr;
     QAbstractPhysicsNode *frontendNode = nullptr;
     bool isRemoved = false;
@@ -3,19 +3,22 @@
 
 #include "qphysxactorbody_p.h"
 
-#include "PxMaterial.h"
 #include "PxPhysics.h"
 #include "PxRigidDynamic.h"
 #include "PxRigidActor.h"
 #include "PxScene.h"
+#include "PxShape.h"
 
 #include "physxnode/qphysxworld_p.h"
 #include "qabstractphysicsbody_p.h"
 #include "qheightfieldshape_p.h"
+#include "qmeshshape_p.h"
 #include "qphysicsutils_p.h"
 #include "qplaneshape_p.h"
 #include "qstaticphysxobjects_p.h"
 
+#include <QtCore/QVarLengthArray>
+
 #define PHYSX_RELEASE(x)                                                                           \
     if (x != nullptr) {                                                                            \
         x->release();                                                                              \
@@ -50,9 +53,17 @@ QPhysXActorBody::QPhysXActorBody(QAbstractPhysicsNode *frontEnd) : QAbstractPhys
 void QPhysXActorBody::cleanup(QPhysXWorld *physX)
 {
     if (actor) {
-        physX->scene->removeActor(*actor);
-        PHYSX_RELEASE(actor);
+        // Removed and released together with the other actors cleaned up this frame, see
+        // QPhysXWorld::removePendingActors()
+        physX->removedActors.push_back(actor);
+        physX->releasedActors.push_back(actor);
+        actor = nullptr;
     }
+    // Shared shapes are owned by the shape cache, which releases the exclusive ones as well
+    for (auto *shape : std::as_const(shapes))
+        physX->shapeCache.release(shape);
+    shapes.clear();
+    collisionShapes.clear();
     QAbstractPhysXNode::cleanup(physX);
 }
 
@@ -64,25 +75,18 @@ void QPhysXActorBody::init(QPhysicsWorld * /*world*/, QPhysXWorld *physX)
     createActor(physX);
 
     actor->userData = reinterpret_cast<void *>(frontendNode);
-    physX->scene->addActor(*actor);
+    // Added to the scene together with the other new actors, see
+    // QPhysXWorld::addPendingActors()
+    physX->pendingActors.push_back(actor);
     setShapesDirty(true);
 }
 
 void QPhysXActorBody::sync(float /*deltaTime*/,
                            QHash<QQuick3DNode *, QMatrix4x4> & /*transformCache*/)
 {
-    auto *body = static_cast<QAbstractPhysicsBody *>(frontendNode);
-    if (QPhysicsMaterial *qtMaterial = body->physicsMaterial()) {
-        const float staticFriction = qtMaterial->staticFriction();
-        const float dynamicFriction = qtMaterial->dynamicFriction();
-        const float restitution = qtMaterial->restitution();
-        if (material->getStaticFriction() != staticFriction)
-            material->setStaticFriction(staticFriction);
-        if (material->getDynamicFriction() != dynamicFriction)
-            material->setDynamicFriction(dynamicFriction);
-        if (material->getRestitution() != restitution)
-            material->setRestitution(restitution);
-    }
+    // Material changes are applied by the material registry, see
+    // QPhysXMaterialRegistry::updateDirtyMaterials(). A material that was replaced is picked up
+    // when the shapes are rebuilt, see buildShapes().
 }
 
 void QPhysXActorBody::markDirtyShapes()
@@ -90,29 +94,13 @@ void QPhysXActorBody::markDirtyShapes()
     if (!frontendNode || !actor)
         return;
 
-    // Go through the shapes and look for a change in pose (rotation, position)
-    // TODO: it is likely cheaper to connect a signal for changes on the position and rotation
-    // property and mark the node dirty then.
-    if (!shapesDirty()) {
-        const auto &collisionShapes = frontendNode->getCollisionShapesList();
-        const auto &physXShapes = shapes;
-
-        const int len = collisionShapes.size();
-        if (physXShapes.size() != len) {
-            // This should not really happen but check it anyway
-            setShapesDirty(true);
-        } else {
-            for (int i = 0; i < len; i++) {
-                auto poseNew = getPhysXLocalTransform(collisionShapes[i]);
-                auto poseOld = physXShapes[i]->getLocalPose();
-
-                if (!QPhysicsUtils::fuzzyEquals(poseNew, poseOld)) {
-                    setShapesDirty(true);
-                    break;
-                }
-            }
-        }
-    }
+    // Changes to the pose, geometry or list of the collision shapes are reported through
+    // signals so there is nothing to poll here.
+
+    // Shapes are shared so changing the filters or the material means fetching other shapes
+    // from the cache
+    if (filtersDirty() || materialDirty())
+        setShapesDirty(true);
 }
 
 void QPhysXActorBody::rebuildDirtyShapes(QPhysicsWorld * /*world*/, QPhysXWorld *physX)
@@ -141,63 +129,178 @@ physx::PxTransform QPhysXActorBody::getGlobalPose()
     return actor->getGlobalPose();
 }
 
-void QPhysXActorBody::buildShapes(QPhysXWorld * /*physX*/)
+// Mesh shapes that are cooked asynchronously have no geometry until the mesh is ready
+static bool isPending(QAbstractCollisionShape *collisionShape)
+{
+    auto *meshShape = qobject_cast<QMeshShape *>(collisionShape);
+    return meshShape && meshShape->status() == QMeshShape::Status::Loading;
+}
+
+static physx::PxFilterData getFilterData(const QAbstractPhysicsNode *node)
+{
+    physx::PxFilterData filterData;
+    filterData.word0 = node->filterGroup();
+    filterData.word1 = node->filterIgnoreGroups();
+    return filterData;
+}
+
+void QPhysXActorBody::acquireShapes(QPhysXWorld *physX, QVector<physx::PxShape *> &physXShapes,
+                                    QVector<QAbstractCollisionShape *> &sourceShapes)
+{
+    if (!material)
+        return;
+
+    const physx::PxFilterData filterData = getFilterData(frontendNode);
+    const bool isTrigger = useTriggerFlag();
+
+    for (const auto &collisionShape : frontendNode->getCollisionShapesList()) {
+        const physx::PxTransform pose = getPhysXLocalTransform(collisionShape);
+        for (auto *geom : collisionShape->getPhysXGeometries()) {
+            physXShapes.push_back(
+                    physX->shapeCache.acquire(*geom, material, filterData, pose, isTrigger));
+            sourceShapes.push_back(collisionShape);
+        }
+    }
+}
+
+static bool sameGeometryTypes(const QVarLengthArray<physx::PxShape *, 1> &shapes,
+                              const QList<physx::PxGeometry *> &geometries)
+{
+    if (shapes.size() != geometries.size())
+        return false;
+    for (qsizetype i = 0; i < shapes.size(); i++) {
+        if (shapes[i]->getGeometryType() != geometries[i]->getType())
+            return false;
+    }
+    return true;
+}
+
+bool QPhysXActorBody::buildShapes(QPhysXWorld *physX)
 {
     auto body = actor;
-    for (auto *shape : shapes) {
-        body->detachShape(*shape);
-        PHYSX_RELEASE(shape);
+    const QSet<QAbstractCollisionShape *> dirtyShapes = takeDirtyCollisionShapes();
+    const bool filtersChanged = filtersDirty();
+    const bool isTrigger = useTriggerFlag();
+    const physx::PxFilterData filterData = getFilterData(frontendNode);
+
+    // The old material is given back after the shapes using it have been replaced
+    physx::PxMaterial *oldMaterial = nullptr;
+    if (materialDirty()) {
+        oldMaterial = std::exchange(material, nullptr);
+        createMaterial(physX);
     }
+    const bool materialChanged = oldMaterial && material != oldMaterial;
 
-    // TODO: Only remove changed shapes?
-    shapes.clear();
+    // Keep the PhysX shapes that still belong to the body so that only added or removed
+    // shapes are attached or detached. A collision shape made of several geometries has one
+    // PhysX shape for each of them.
+    QHash<QAbstractCollisionShape *, QVarLengthArray<physx::PxShape *, 1>> oldShapes;
+    for (qsizetype i = 0; i < shapes.size(); i++)
+        oldShapes[collisionShapes[i]].append(shapes[i]);
+
+    QVector<physx::PxShape *> newShapes;
+    QVector<QAbstractCollisionShape *> newCollisionShapes;
+    bool changed = false;
+    hasPendingShapes = false;
 
     for (const auto &collisionShape : frontendNode->getCollisionShapesList()) {
-        // TODO: shapes can be shared between multiple actors.
-        // Do we need to create new ones for every body?
-        auto *geom = collisionShape->getPhysXGeometry();
-        if (!geom || !material)
+        const auto oldShapeList = oldShapes.take(collisionShape);
+        const physx::PxTransform pose = getPhysXLocalTransform(collisionShape);
+        const bool isNew = oldShapeList.isEmpty();
+        const bool geometryDirty = isNew || dirtyShapes.contains(collisionShape);
+        const bool poseChanged =
+                !isNew && !QPhysicsUtils::fuzzyEquals(pose, oldShapeList.first()->getLocalPose());
+
+        if (!geometryDirty && !filtersChanged && !poseChanged && !materialChanged) {
+            for (auto *oldShape : oldShapeList) {
+                newShapes.push_back(oldShape);
+                newCollisionShapes.push_back(collisionShape);
+            }
             continue;
+        }
 
-        auto &s_physx = StaticPhysXObjects::getReference();
-        auto physXShape = s_physx.physics->createShape(*geom, *material);
-
-        if (useTriggerFlag()) {
-            physXShape->setFlag(physx::PxShapeFlag::eSIMULATION_SHAPE, false);
-            physXShape->setFlag(physx::PxShapeFlag::eTRIGGER_SHAPE, true);
+        const QList<physx::PxGeometry *> geometries =
+                geometryDirty ? collisionShape->getPhysXGeometries() : QList<physx::PxGeometry *>();
+
+        // Exclusive shapes are updated in place as long as the geometry types stay the same
+        if (!isNew && oldShapeList.first()->isExclusive()
+            && (!geometryDirty || sameGeometryTypes(oldShapeList, geometries))) {
+            for (qsizetype i = 0; i < oldShapeList.size(); i++) {
+                auto *oldShape = oldShapeList[i];
+                if (geometryDirty)
+                    oldShape->setGeometry(*geometries[i]);
+                if (poseChanged)
+                    oldShape->setLocalPose(pose);
+                if (filtersChanged)
+                    oldShape->setSimulationFilterData(filterData);
+                if (materialChanged)
+                    oldShape->setMaterials(&material, 1);
+                newShapes.push_back(oldShape);
+                newCollisionShapes.push_back(collisionShape);
+            }
+            changed |= geometryDirty || poseChanged;
+            continue;
         }
 
-        { // Setup filtering
-            physx::PxFilterData filterData;
-            filterData.word0 = frontendNode->filterGroup();
-            filterData.word1 = frontendNode->filterIgnoreGroups();
-            physXShape->setSimulationFilterData(filterData);
+        // Shared shapes can not be modified while they are attached, so the shapes matching the
+        // new parameters are fetched from the cache instead. A collider that moves or changes
+        // after it was added is likely animated and gets exclusive shapes, so that the following
+        // changes neither create new shapes nor detach and attach them every frame.
+        const bool exclusive = !isNew && (geometryDirty || poseChanged);
+        QVarLengthArray<physx::PxShape *, 1> physXShapes;
+        if (material) {
+            const auto acquire = [&](const physx::PxGeometry &geom) {
+                return exclusive ? QPhysXShapeCache::createExclusive(geom, material, filterData,
+                                                                     pose, isTrigger)
+                                 : physX->shapeCache.acquire(geom, material, filterData, pose,
+                                                             isTrigger);
+            };
+            if (geometryDirty) {
+                for (auto *geom : geometries)
+                    physXShapes.append(acquire(*geom));
+            } else {
+                for (auto *oldShape : oldShapeList)
+                    physXShapes.append(acquire(oldShape->getGeometry().any()));
+            }
         }
 
-        shapes.push_back(physXShape);
-        physXShape->setLocalPose(getPhysXLocalTransform(collisionShape));
-        body->attachShape(*physXShape);
-    }
+        if (physXShapes != oldShapeList) {
+            for (auto *oldShape : oldShapeList)
+                body->detachShape(*oldShape);
+            for (auto *physXShape : std::as_const(physXShapes))
+                body->attachShape(*physXShape);
+            changed = true;
+        }
+        for (auto *oldShape : oldShapeList)
+            physX->shapeCache.release(oldShape);
 
-    // Filters are always clean after building shapes
-    setFiltersDirty(false);
-}
+        if (physXShapes.isEmpty()) {
+            hasPendingShapes |= isPending(collisionShape);
+            continue;
+        }
 
-void QPhysXActorBody::updateFilters()
-{
-    if (!filtersDirty())
-        return;
+        for (auto *physXShape : std::as_const(physXShapes)) {
+            newShapes.push_back(physXShape);
+            newCollisionShapes.push_back(collisionShape);
+        }
+    }
 
-    // Go through all shapes and set the filter group and mask.
-    // TODO: What about shared shapes on several actors?
-    for (auto &physXShape : shapes) {
-        physx::PxFilterData filterData;
-        filterData.word0 = frontendNode->filterGroup();
-        filterData.word1 = frontendNode->filterIgnoreGroups();
-        physXShape->setSimulationFilterData(filterData);
+    // Remove the shapes that are no longer part of the body
+    for (const auto &oldShapeList : std::as_const(oldShapes)) {
+        for (auto *physXShape : oldShapeList) {
+            body->detachShape(*physXShape);
+            physX->shapeCache.release(physXShape);
+            changed = true;
+        }
     }
 
+    shapes = std::move(newShapes);
+    collisionShapes = std::move(newCollisionShapes);
+    releaseMaterial(physX, oldMaterial);
+
+    // Filters are always clean after building shapes
     setFiltersDirty(false);
+    return changed;
 }
 
 QT_END_NAMESPACE
@@ -37,10 +37,16 @@ public:
 
     bool debugGeometryCapability() override;
     physx::PxTransform getGlobalPose() override;
-    void buildShapes(QPhysXWorld *physX);
-    void updateFilters() override;
+    bool buildShapes(QPhysXWorld *physX);
+    // Acquires the shapes for the current collision shapes of the frontend node without
+    // attaching them to the actor
+    void acquireShapes(QPhysXWorld *physX, QVector<physx::PxShape *> &physXShapes,
+                       QVector<QAbstractCollisionShape *> &sourceShapes);
 
     physx::PxRigidActor *actor = nullptr;
+    // Set by buildShapes() if a collision shape is still being cooked, the body does not take
+    // part in the simulation until it is ready
+    bool hasPendingShapes = false;
 };
 
 QT_END_NAMESPACE
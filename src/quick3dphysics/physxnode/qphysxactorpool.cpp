@@ -0,0 +1,99 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "qphysxactorpool_p.h"
+
+#include "PxRigidDynamic.h"
+#include "PxShape.h"
+
+#include "physxnode/qphysxshapecache_p.h"
+
+#include <QVarLengthArray>
+
+QT_BEGIN_NAMESPACE
+
+// Shapes come from the shape cache, so identical colliders are the very same shapes
+static QByteArray createKey(const QList<physx::PxShape *> &shapes)
+{
+    return QByteArray(reinterpret_cast<const char *>(shapes.constData()),
+                      shapes.size() * sizeof(physx::PxShape *));
+}
+
+QPhysXActorPool::QPhysXActorPool(QPhysXShapeCache &shapeCache) : m_shapeCache(shapeCache) { }
+
+QPhysXActorPool::~QPhysXActorPool()
+{
+    // Has to be cleared before the PhysX objects are released
+    Q_ASSERT(m_actors.isEmpty());
+}
+
+int QPhysXActorPool::capacity() const
+{
+    return m_capacity;
+}
+
+void QPhysXActorPool::setCapacity(int capacity)
+{
+    m_capacity = qMax(capacity, 0);
+    trim(m_capacity);
+}
+
+bool QPhysXActorPool::isEmpty() const
+{
+    return m_size == 0;
+}
+
+bool QPhysXActorPool::isFull() const
+{
+    return m_size >= m_capacity;
+}
+
+void QPhysXActorPool::park(physx::PxRigidDynamic *actor, const QList<physx::PxShape *> &shapes)
+{
+    Q_ASSERT(!isFull());
+    m_actors[createKey(shapes)].append(actor);
+    m_size++;
+}
+
+physx::PxRigidDynamic *QPhysXActorPool::take(const QList<physx::PxShape *> &shapes)
+{
+    auto it = m_actors.find(createKey(shapes));
+    if (it == m_actors.end())
+        return nullptr;
+
+    physx::PxRigidDynamic *actor = it->takeLast();
+    if (it->isEmpty())
+        m_actors.erase(it);
+    m_size--;
+    return actor;
+}
+
+void QPhysXActorPool::clear()
+{
+    trim(0);
+}
+
+void QPhysXActorPool::release(physx::PxRigidDynamic *actor)
+{
+    QVarLengthArray<physx::PxShape *, 8> shapes(actor->getNbShapes());
+    actor->getShapes(shapes.data(), shapes.size());
+    actor->release();
+    for (auto *shape : shapes)
+        m_shapeCache.release(shape);
+}
+
+void QPhysXActorPool::trim(qsizetype size)
+{
+    for (auto it = m_actors.begin(); it != m_actors.end() && m_size > size;) {
+        while (!it->isEmpty() && m_size > size) {
+            release(it->takeLast());
+            m_size--;
+        }
+        if (it->isEmpty())
+            it = m_actors.erase(it);
+        else
+            ++it;
+    }
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,67 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef QPHYSXACTORPOOL_P_H
+#define QPHYSXACTORPOOL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qtconfigmacros.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+
+namespace physx {
+class PxRigidDynamic;
+class PxShape;
+}
+
+QT_BEGIN_NAMESPACE
+
+class QPhysXShapeCache;
+
+// Keeps the actors of destroyed dynamic bodies, with their shapes still attached, so that new
+// bodies with the same colliders can reuse them instead of creating a new actor. Parked actors
+// are not in the scene and each of them holds one shape cache reference per attached shape.
+class QPhysXActorPool
+{
+public:
+    explicit QPhysXActorPool(QPhysXShapeCache &shapeCache);
+    ~QPhysXActorPool();
+
+    int capacity() const;
+    void setCapacity(int capacity);
+    bool isEmpty() const;
+    bool isFull() const;
+
+    // Takes ownership of an actor that has been removed from the scene, together with one shape
+    // cache reference for each of its shapes. The pool must not be full.
+    void park(physx::PxRigidDynamic *actor, const QList<physx::PxShape *> &shapes);
+    // Returns a parked actor with exactly these shapes attached, or nullptr
+    physx::PxRigidDynamic *take(const QList<physx::PxShape *> &shapes);
+
+    void clear();
+
+private:
+    void release(physx::PxRigidDynamic *actor);
+    void trim(qsizetype size);
+
+    QPhysXShapeCache &m_shapeCache;
+    QHash<QByteArray, QList<physx::PxRigidDynamic *>> m_actors;
+    qsizetype m_size = 0;
+    int m_capacity = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QPHYSXACTORPOOL_P_H
@@ -4,6 +4,7 @@
 #include "qphysxcharactercontroller_p.h"
 
 #include "PxRigidDynamic.h"
+#include "PxShape.h"
 #include "characterkinematic/PxController.h"
 #include "characterkinematic/PxControllerManager.h"
 #include "characterkinematic/PxCapsuleController.h"
@@ -174,9 +175,23 @@ void QPhysXCharacterController::sync(float deltaTime,
                 controller->move(displacement, displacement.magnitude() / 100, deltaTime, {});
         characterController->setCollisions(QCharacterController::Collisions(uint(collisions)));
     }
-    // QCharacterController has a material property, but we don't inherit from
-    // QPhysXMaterialBody, so we create the material manually in init()
-    // TODO: handle material changes
+}
+
+void QPhysXCharacterController::rebuildDirtyShapes(QPhysicsWorld * /*world*/,
+                                                   QPhysXWorld *physX)
+{
+    // Changes to the material properties are applied by the material registry, but a replaced
+    // material has to be set on the shape of the controller's actor
+    if (controller == nullptr || !materialDirty())
+        return;
+
+    physx::PxMaterial *oldMaterial = std::exchange(material, nullptr);
+    createMaterial(physX);
+    auto *actor = controller->getActor();
+    physx::PxShape *shape = nullptr;
+    if (actor && material != oldMaterial && actor->getShapes(&shape, 1) == 1)
+        shape->setMaterials(&material, 1);
+    releaseMaterial(physX, oldMaterial);
 }
 
 void QPhysXCharacterController::createMaterial(QPhysXWorld *physX)
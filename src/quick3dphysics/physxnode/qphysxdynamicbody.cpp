@@ -4,13 +4,18 @@
 #include "qphysxdynamicbody_p.h"
 
 #include "PxRigidDynamic.h"
+#include "PxScene.h"
+#include "PxShape.h"
 
+#include "physxnode/qphysxworld_p.h"
 #include "qphysicscommands_p.h"
 #include "qphysicsutils_p.h"
 #include "qphysicsworld_p.h"
 #include "qabstractphysicsbody_p.h"
 #include "qdynamicrigidbody_p.h"
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 static void processCommandQueue(QQueue<QPhysicsCommand *> &commandQueue,
@@ -106,8 +111,10 @@ DebugDrawBodyType QPhysXDynamicBody::getDebugDrawBodyType()
 void QPhysXDynamicBody::sync(float deltaTime, QHash<QQuick3DNode *, QMatrix4x4> &transformCache)
 {
     auto *dynamicRigidBody = static_cast<QDynamicRigidBody *>(frontendNode);
-    // first update front end node from physx simulation
-    dynamicRigidBody->updateFromPhysicsTransform(actor->getGlobalPose());
+    // first update front end node from physx simulation, a sleeping body has not moved since
+    // setSleeping picked up its final pose
+    if (!isSleeping)
+        dynamicRigidBody->updateFromPhysicsTransform(actor->getGlobalPose());
 
     auto *dynamicActor = static_cast<physx::PxRigidDynamic *>(actor);
     processCommandQueue(dynamicRigidBody->commandQueue(), *dynamicRigidBody, *dynamicActor);
@@ -121,16 +128,21 @@ void QPhysXDynamicBody::sync(float deltaTime, QHash<QQuick3DNode *, QMatrix4x4>
         dynamicActor->setRigidDynamicLockFlags(getLockFlags(dynamicRigidBody));
     }
 
+    const bool posePreview = dynamicRigidBody->enablePoseIntegrationPreview();
+    if (posePreview
+        != bool(dynamicActor->getRigidBodyFlags()
+                & physx::PxRigidBodyFlag::eENABLE_POSE_INTEGRATION_PREVIEW))
+        dynamicActor->setRigidBodyFlag(physx::PxRigidBodyFlag::eENABLE_POSE_INTEGRATION_PREVIEW,
+                                       posePreview);
+
     const bool disabledPrevious = actor->getActorFlags() & physx::PxActorFlag::eDISABLE_SIMULATION;
-    const bool disabled = !dynamicRigidBody->simulationEnabled();
+    const bool disabled = !dynamicRigidBody->simulationEnabled() || hasPendingShapes;
     if (disabled != disabledPrevious) {
         actor->setActorFlag(physx::PxActorFlag::eDISABLE_SIMULATION, disabled);
         if (!disabled && !dynamicRigidBody->isKinematic())
             dynamicActor->wakeUp();
     }
 
-    dynamicRigidBody->setIsSleeping(dynamicActor->isSleeping());
-
     QPhysXActorBody::sync(deltaTime, transformCache);
 }
 
@@ -139,26 +151,29 @@ void QPhysXDynamicBody::rebuildDirtyShapes(QPhysicsWorld *world, QPhysXWorld *ph
     if (!shapesDirty())
         return;
 
-    buildShapes(physX);
+    const bool shapesChanged = buildShapes(physX);
 
     QDynamicRigidBody *drb = static_cast<QDynamicRigidBody *>(frontendNode);
 
-    // Density must be set after shapes so the inertia tensor is set
-    if (!drb->hasStaticShapes()) {
+    // Density must be set after shapes so the inertia tensor is set. The mass properties only
+    // need updating when the shapes actually changed, or when the actor comes from the pool
+    // and still has the mass properties of its previous body.
+    if (!drb->hasStaticShapes() && (shapesChanged || isRecycled)) {
         // Body with only dynamic shapes, set/calculate mass
         QPhysicsCommand *command = nullptr;
         switch (drb->massMode()) {
         case QDynamicRigidBody::MassMode::DefaultDensity: {
-            command = new QPhysicsCommandSetDensity(world->defaultDensity());
+            command = new QPhysicsCommandSetDensity(world->defaultDensity(),
+                                                    &physX->massPropertiesCache);
             break;
         }
         case QDynamicRigidBody::MassMode::CustomDensity: {
-            command = new QPhysicsCommandSetDensity(drb->density());
+            command = new QPhysicsCommandSetDensity(drb->density(), &physX->massPropertiesCache);
             break;
         }
         case QDynamicRigidBody::MassMode::Mass: {
             const float mass = qMax(drb->mass(), 0.f);
-            command = new QPhysicsCommandSetMass(mass);
+            command = new QPhysicsCommandSetMass(mass, &physX->massPropertiesCache);
             break;
         }
         case QDynamicRigidBody::MassMode::MassAndInertiaTensor: {
@@ -174,7 +189,7 @@ void QPhysXDynamicBody::rebuildDirtyShapes(QPhysicsWorld *world, QPhysXWorld *ph
         }
 
         drb->commandQueue().enqueue(command);
-    } else if (!drb->isKinematic()) {
+    } else if (drb->hasStaticShapes() && !drb->isKinematic()) {
         // Body with static shapes that is not kinematic, this is disallowed
         qWarning() << "Cannot make body containing trimesh/heightfield/plane non-kinematic, "
                       "forcing kinematic.";
@@ -192,6 +207,7 @@ void QPhysXDynamicBody::rebuildDirtyShapes(QPhysicsWorld *world, QPhysXWorld *ph
         dynamicBody->setRigidBodyFlag(physx::PxRigidBodyFlag::eENABLE_SPECULATIVE_CCD, isKinematic);
     }
 
+    isRecycled = false;
     setShapesDirty(false);
 }
 
@@ -201,4 +217,107 @@ void QPhysXDynamicBody::updateDefaultDensity(float density)
     rigidBody->updateDefaultDensity(density);
 }
 
+void QPhysXDynamicBody::createActor(QPhysXWorld *physX)
+{
+    QPhysXActorBody::createActor(physX);
+    // The sleep state is driven by the onWake/onSleep callbacks instead of polling every frame
+    actor->setActorFlag(physx::PxActorFlag::eSEND_SLEEP_NOTIFIES, true);
+}
+
+void QPhysXDynamicBody::init(QPhysicsWorld *world, QPhysXWorld *physX)
+{
+    if (physX->actorPool.isEmpty()) {
+        QPhysXRigidBody::init(world, physX);
+        return;
+    }
+
+    Q_ASSERT(!actor);
+    createMaterial(physX);
+
+    // Shapes come from the shape cache, so a parked actor with the same colliders has exactly
+    // the shapes this body would acquire.
+    QVector<physx::PxShape *> wantedShapes;
+    QVector<QAbstractCollisionShape *> wantedCollisionShapes;
+    acquireShapes(physX, wantedShapes, wantedCollisionShapes);
+    auto *dynamicActor = physX->actorPool.take(wantedShapes);
+
+    // The parked actor brings its own shape references
+    for (auto *shape : std::as_const(wantedShapes))
+        physX->shapeCache.release(shape);
+
+    if (!dynamicActor) {
+        // Not calling init() since it would create the material again
+        createActor(physX);
+        actor->userData = reinterpret_cast<void *>(frontendNode);
+        physX->pendingActors.push_back(actor);
+        setShapesDirty(true);
+        return;
+    }
+
+    actor = dynamicActor;
+    shapes = std::move(wantedShapes);
+    collisionShapes = std::move(wantedCollisionShapes);
+    takeDirtyCollisionShapes();
+    isRecycled = true;
+
+    actor->setGlobalPose(QPhysicsUtils::toPhysXTransform(frontendNode->scenePosition(),
+                                                         frontendNode->sceneRotation()));
+    actor->userData = reinterpret_cast<void *>(frontendNode);
+    physX->pendingActors.push_back(actor);
+    // Picks up the collision shapes that were added after acquireShapes and sets the mass and
+    // the body flags
+    setShapesDirty(true);
+}
+
+void QPhysXDynamicBody::cleanup(QPhysXWorld *physX)
+{
+    physX->wokenBodies.remove(this);
+    physX->sleepStateChangedBodies.removeAll(this);
+
+    // Actors with exclusive shapes can never match the shapes of another body
+    const bool hasExclusiveShapes = std::any_of(shapes.cbegin(), shapes.cend(),
+                                                [](auto *shape) { return shape->isExclusive(); });
+    if (actor && !shapes.isEmpty() && !hasExclusiveShapes && !physX->actorPool.isFull()) {
+        auto *dynamicActor = static_cast<physx::PxRigidDynamic *>(actor);
+
+        // Reset the state that survives removing the actor from the scene, these calls are only
+        // valid while the actor is in the scene. It is removed at the end of the cleanup, before
+        // any new body can take it from the pool.
+        actor->setActorFlag(physx::PxActorFlag::eDISABLE_SIMULATION, false);
+        // Gravity is only set by a command when gravityEnabled changes, so the next body expects
+        // the default of a new actor
+        actor->setActorFlag(physx::PxActorFlag::eDISABLE_GRAVITY, false);
+        if (!(dynamicActor->getRigidBodyFlags() & physx::PxRigidBodyFlag::eKINEMATIC)) {
+            dynamicActor->setLinearVelocity(physx::PxVec3(0));
+            dynamicActor->setAngularVelocity(physx::PxVec3(0));
+            dynamicActor->clearForce();
+            dynamicActor->clearTorque();
+            dynamicActor->wakeUp();
+        }
+
+        physX->removedActors.push_back(actor);
+        actor->userData = nullptr;
+
+        // The pool owns the actor and the shape references now
+        physX->actorPool.park(dynamicActor, shapes);
+        actor = nullptr;
+        shapes.clear();
+        collisionShapes.clear();
+    }
+
+    QPhysXRigidBody::cleanup(physX);
+}
+
+void QPhysXDynamicBody::setSleeping(bool sleeping)
+{
+    auto *dynamicRigidBody = static_cast<QDynamicRigidBody *>(frontendNode);
+
+    // Pick up the pose from the step the body came to rest in since sync skips sleeping bodies
+    if (sleeping)
+        dynamicRigidBody->updateFromPhysicsTransform(actor->getGlobalPose());
+
+    isSleeping = sleeping;
+    dynamicRigidBody->setIsSleeping(sleeping);
+}
+
 QT_END_NAMESPACE
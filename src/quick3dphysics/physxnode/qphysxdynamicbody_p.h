@@ -32,6 +32,14 @@ public:
     void sync(float deltaTime, QHash<QQuick3DNode *, QMatrix4x4> &transformCache) override;
     void rebuildDirtyShapes(QPhysicsWorld *world, QPhysXWorld *physX) override;
     void updateDefaultDensity(float density) override;
+    void createActor(QPhysXWorld *physX) override;
+    void init(QPhysicsWorld *world, QPhysXWorld *physX) override;
+    void cleanup(QPhysXWorld *physX) override;
+    void setSleeping(bool sleeping);
+
+    bool isSleeping = false;
+    // The actor was taken from the actor pool and still has the mass of its previous body
+    bool isRecycled = false;
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,134 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "qphysxmasspropertiescache_p.h"
+
+#include "PxRigidBody.h"
+#include "PxShape.h"
+#include "extensions/PxRigidBodyExt.h"
+#include "geometry/PxConvexMesh.h"
+#include "geometry/PxGeometryHelpers.h"
+#include "geometry/PxHeightField.h"
+#include "geometry/PxTriangleMesh.h"
+
+#include "physxnode/qphysxshapecache_p.h"
+
+#include <QVarLengthArray>
+
+QT_BEGIN_NAMESPACE
+
+static physx::PxBase *meshOf(const physx::PxGeometryHolder &geometry)
+{
+    switch (geometry.getType()) {
+    case physx::PxGeometryType::eCONVEXMESH:
+        return geometry.convexMesh().convexMesh;
+    case physx::PxGeometryType::eTRIANGLEMESH:
+        return geometry.triangleMesh().triangleMesh;
+    case physx::PxGeometryType::eHEIGHTFIELD:
+        return geometry.heightField().heightField;
+    default:
+        return nullptr;
+    }
+}
+
+static void acquireMeshReference(physx::PxBase *mesh)
+{
+    if (auto *convexMesh = mesh->is<physx::PxConvexMesh>())
+        convexMesh->acquireReference();
+    else if (auto *triangleMesh = mesh->is<physx::PxTriangleMesh>())
+        triangleMesh->acquireReference();
+    else if (auto *heightField = mesh->is<physx::PxHeightField>())
+        heightField->acquireReference();
+}
+
+QPhysXMassPropertiesCache::~QPhysXMassPropertiesCache()
+{
+    clear();
+}
+
+void QPhysXMassPropertiesCache::updateMassAndInertia(physx::PxRigidBody &body, float density)
+{
+    update(body, Mode::Density, density);
+}
+
+void QPhysXMassPropertiesCache::setMassAndUpdateInertia(physx::PxRigidBody &body, float mass)
+{
+    update(body, Mode::Mass, mass);
+}
+
+void QPhysXMassPropertiesCache::clear()
+{
+    for (const auto &entry : std::as_const(m_entries))
+        releaseMeshes(entry);
+    m_entries.clear();
+    m_useCount = 0;
+}
+
+void QPhysXMassPropertiesCache::releaseMeshes(const Entry &entry)
+{
+    for (auto *mesh : entry.meshes)
+        mesh->release();
+}
+
+void QPhysXMassPropertiesCache::evictLeastRecentlyUsed()
+{
+    // Only called on a miss with a full cache, and a miss has to integrate the shapes anyway, so
+    // a linear scan is cheap in comparison.
+    auto oldest = m_entries.begin();
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        if (it->lastUse < oldest->lastUse)
+            oldest = it;
+    }
+    if (oldest == m_entries.end())
+        return;
+    releaseMeshes(*oldest);
+    m_entries.erase(oldest);
+}
+
+void QPhysXMassPropertiesCache::update(physx::PxRigidBody &body, Mode mode, float value)
+{
+    const physx::PxU32 numShapes = body.getNbShapes();
+    QVarLengthArray<physx::PxShape *> shapes(numShapes);
+    body.getShapes(shapes.data(), numShapes);
+
+    // Only the simulation shapes contribute to the mass, see PxRigidBodyExt
+    QByteArray key;
+    QList<physx::PxBase *> meshes;
+    key.append(char(mode));
+    key.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    for (auto *shape : shapes) {
+        if (!(shape->getFlags() & physx::PxShapeFlag::eSIMULATION_SHAPE))
+            continue;
+        const physx::PxGeometryHolder geometry = shape->getGeometry();
+        QPhysXShapeCache::appendGeometryKey(key, geometry.any());
+        QPhysXShapeCache::appendTransformKey(key, shape->getLocalPose());
+        if (auto *mesh = meshOf(geometry))
+            meshes.append(mesh);
+    }
+
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        it->lastUse = ++m_useCount;
+        body.setMass(it->mass);
+        body.setCMassLocalPose(it->massLocalPose);
+        body.setMassSpaceInertiaTensor(it->inertia);
+        return;
+    }
+
+    if (mode == Mode::Density)
+        physx::PxRigidBodyExt::updateMassAndInertia(body, value);
+    else
+        physx::PxRigidBodyExt::setMassAndUpdateInertia(body, value);
+
+    if (m_entries.size() >= MaxEntries)
+        evictLeastRecentlyUsed();
+
+    for (auto *mesh : std::as_const(meshes))
+        acquireMeshReference(mesh);
+
+    m_entries.insert(key,
+                     { body.getMass(), body.getCMassLocalPose(), body.getMassSpaceInertiaTensor(),
+                       std::move(meshes), ++m_useCount });
+}
+
+QT_END_NAMESPACE
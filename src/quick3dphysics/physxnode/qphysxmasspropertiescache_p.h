@@ -0,0 +1,73 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef PHYSXMASSPROPERTIESCACHE_H
+#define PHYSXMASSPROPERTIESCACHE_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "foundation/PxTransform.h"
+#include "foundation/PxVec3.h"
+#include "qtconfigmacros.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+
+namespace physx {
+class PxBase;
+class PxRigidBody;
+}
+
+QT_BEGIN_NAMESPACE
+
+// Caches the mass, center of mass and inertia computed by PxRigidBodyExt for a set of shapes so
+// bodies with the same colliders, or bodies whose shapes were rebuilt without changing, do not
+// integrate their shapes again.
+class QPhysXMassPropertiesCache
+{
+public:
+    ~QPhysXMassPropertiesCache();
+
+    // Same as PxRigidBodyExt::updateMassAndInertia(body, density)
+    void updateMassAndInertia(physx::PxRigidBody &body, float density);
+    // Same as PxRigidBodyExt::setMassAndUpdateInertia(body, mass)
+    void setMassAndUpdateInertia(physx::PxRigidBody &body, float mass);
+
+    void clear();
+
+private:
+    enum class Mode : quint8 { Density, Mass };
+
+    struct Entry
+    {
+        float mass = 0.f;
+        physx::PxTransform massLocalPose;
+        physx::PxVec3 inertia;
+        // References to the meshes in the key so their addresses are not reused while cached
+        QList<physx::PxBase *> meshes;
+        // Value of m_useCount when the entry was last looked up, for LRU eviction
+        quint64 lastUse = 0;
+    };
+
+    void update(physx::PxRigidBody &body, Mode mode, float value);
+    void evictLeastRecentlyUsed();
+    static void releaseMeshes(const Entry &entry);
+
+    static constexpr qsizetype MaxEntries = 1024;
+    QHash<QByteArray, Entry> m_entries;
+    quint64 m_useCount = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif
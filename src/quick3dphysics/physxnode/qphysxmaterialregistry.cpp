@@ -0,0 +1,107 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "qphysxmaterialregistry_p.h"
+
+#include "PxMaterial.h"
+#include "PxPhysics.h"
+
+#include "qphysicsmaterial_p.h"
+#include "qstaticphysxobjects_p.h"
+
+#include <QDebug>
+
+QT_BEGIN_NAMESPACE
+
+QPhysXMaterialRegistry::~QPhysXMaterialRegistry()
+{
+    // All bodies should have given their materials back by now
+    Q_ASSERT(m_entries.isEmpty());
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        disconnectEntry(*it);
+        it.key()->release();
+    }
+}
+
+physx::PxMaterial *QPhysXMaterialRegistry::acquire(QPhysicsMaterial *qtMaterial)
+{
+    Q_ASSERT(qtMaterial);
+
+    if (physx::PxMaterial *material = m_materials.value(qtMaterial)) {
+        m_entries[material].refCount++;
+        return material;
+    }
+
+    auto &s_physx = StaticPhysXObjects::getReference();
+    auto *material = s_physx.physics->createMaterial(
+            qtMaterial->staticFriction(), qtMaterial->dynamicFriction(), qtMaterial->restitution());
+
+    Entry entry;
+    entry.qtMaterial = qtMaterial;
+    entry.refCount = 1;
+
+    // The PxMaterial is updated in between simulation steps, see updateDirtyMaterials()
+    auto markDirty = [this, qtMaterial] { m_dirtyMaterials.insert(qtMaterial); };
+    auto forget = [this, qtMaterial, material] {
+        // Bodies may still hold the PxMaterial, but a new QPhysicsMaterial at the same address
+        // must not pick it up.
+        m_materials.remove(qtMaterial);
+        m_dirtyMaterials.remove(qtMaterial);
+        m_entries[material].qtMaterial = nullptr;
+    };
+    entry.connections = {
+        QObject::connect(qtMaterial, &QPhysicsMaterial::staticFrictionChanged, qtMaterial,
+                         markDirty),
+        QObject::connect(qtMaterial, &QPhysicsMaterial::dynamicFrictionChanged, qtMaterial,
+                         markDirty),
+        QObject::connect(qtMaterial, &QPhysicsMaterial::restitutionChanged, qtMaterial,
+                         markDirty),
+        QObject::connect(qtMaterial, &QObject::destroyed, qtMaterial, forget),
+    };
+
+    m_materials.insert(qtMaterial, material);
+    m_entries.insert(material, entry);
+    return material;
+}
+
+void QPhysXMaterialRegistry::release(physx::PxMaterial *material)
+{
+    auto it = m_entries.find(material);
+    if (it == m_entries.end()) {
+        qWarning() << "QtQuick3DPhysics internal error: releasing a material that is not "
+                      "registered.";
+        return;
+    }
+
+    if (--it->refCount > 0)
+        return;
+
+    if (it->qtMaterial) {
+        m_materials.remove(it->qtMaterial);
+        m_dirtyMaterials.remove(it->qtMaterial);
+    }
+    disconnectEntry(*it);
+    m_entries.erase(it);
+    material->release();
+}
+
+void QPhysXMaterialRegistry::updateDirtyMaterials()
+{
+    for (QPhysicsMaterial *qtMaterial : std::as_const(m_dirtyMaterials)) {
+        physx::PxMaterial *material = m_materials.value(qtMaterial);
+        Q_ASSERT(material);
+        material->setStaticFriction(qtMaterial->staticFriction());
+        material->setDynamicFriction(qtMaterial->dynamicFriction());
+        material->setRestitution(qtMaterial->restitution());
+    }
+    m_dirtyMaterials.clear();
+}
+
+void QPhysXMaterialRegistry::disconnectEntry(Entry &entry)
+{
+    for (const auto &connection : std::as_const(entry.connections))
+        QObject::disconnect(connection);
+    entry.connections.clear();
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,61 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef PHYSXMATERIALREGISTRY_H
+#define PHYSXMATERIALREGISTRY_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qtconfigmacros.h"
+
+#include <QHash>
+#include <QList>
+#include <QMetaObject>
+#include <QSet>
+
+namespace physx {
+class PxMaterial;
+}
+
+QT_BEGIN_NAMESPACE
+
+class QPhysicsMaterial;
+
+// Keeps one PxMaterial per QPhysicsMaterial. Bodies referencing the same QPhysicsMaterial share
+// the PxMaterial, which is only updated when the properties of the QPhysicsMaterial change.
+class QPhysXMaterialRegistry
+{
+public:
+    ~QPhysXMaterialRegistry();
+
+    physx::PxMaterial *acquire(QPhysicsMaterial *qtMaterial);
+    void release(physx::PxMaterial *material);
+    void updateDirtyMaterials();
+
+private:
+    struct Entry
+    {
+        QPhysicsMaterial *qtMaterial = nullptr; // nullptr once the QPhysicsMaterial is destroyed
+        int refCount = 0;
+        QList<QMetaObject::Connection> connections;
+    };
+
+    void disconnectEntry(Entry &entry);
+
+    QHash<QPhysicsMaterial *, physx::PxMaterial *> m_materials;
+    QHash<physx::PxMaterial *, Entry> m_entries;
+    QSet<QPhysicsMaterial *> m_dirtyMaterials;
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -0,0 +1,204 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "qphysxshapecache_p.h"
+
+#include "PxPhysics.h"
+#include "PxShape.h"
+#include "geometry/PxBoxGeometry.h"
+#include "geometry/PxCapsuleGeometry.h"
+#include "geometry/PxConvexMeshGeometry.h"
+#include "geometry/PxHeightFieldGeometry.h"
+#include "geometry/PxSphereGeometry.h"
+#include "geometry/PxTriangleMeshGeometry.h"
+
+#include "qstaticphysxobjects_p.h"
+
+#include <QDebug>
+
+#include <type_traits>
+
+QT_BEGIN_NAMESPACE
+
+template<typename T>
+static void appendValue(QByteArray &key, const T &value)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    key.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+static void appendMeshScale(QByteArray &key, const physx::PxMeshScale &scale)
+{
+    appendValue(key, scale.scale.x);
+    appendValue(key, scale.scale.y);
+    appendValue(key, scale.scale.z);
+    appendValue(key, scale.rotation.x);
+    appendValue(key, scale.rotation.y);
+    appendValue(key, scale.rotation.z);
+    appendValue(key, scale.rotation.w);
+}
+
+void QPhysXShapeCache::appendGeometryKey(QByteArray &key, const physx::PxGeometry &geometry)
+{
+    const physx::PxGeometryType::Enum type = geometry.getType();
+    appendValue(key, type);
+
+    switch (type) {
+    case physx::PxGeometryType::eSPHERE: {
+        const auto &sphere = static_cast<const physx::PxSphereGeometry &>(geometry);
+        appendValue(key, sphere.radius);
+        break;
+    }
+    case physx::PxGeometryType::ePLANE:
+        break;
+    case physx::PxGeometryType::eCAPSULE: {
+        const auto &capsule = static_cast<const physx::PxCapsuleGeometry &>(geometry);
+        appendValue(key, capsule.radius);
+        appendValue(key, capsule.halfHeight);
+        break;
+    }
+    case physx::PxGeometryType::eBOX: {
+        const auto &box = static_cast<const physx::PxBoxGeometry &>(geometry);
+        appendValue(key, box.halfExtents.x);
+        appendValue(key, box.halfExtents.y);
+        appendValue(key, box.halfExtents.z);
+        break;
+    }
+    case physx::PxGeometryType::eCONVEXMESH: {
+        const auto &convex = static_cast<const physx::PxConvexMeshGeometry &>(geometry);
+        appendValue(key, convex.convexMesh);
+        appendMeshScale(key, convex.scale);
+        appendValue(key, static_cast<uint32_t>(convex.meshFlags));
+        break;
+    }
+    case physx::PxGeometryType::eTRIANGLEMESH: {
+        const auto &mesh = static_cast<const physx::PxTriangleMeshGeometry &>(geometry);
+        appendValue(key, mesh.triangleMesh);
+        appendMeshScale(key, mesh.scale);
+        appendValue(key, static_cast<uint32_t>(mesh.meshFlags));
+        break;
+    }
+    case physx::PxGeometryType::eHEIGHTFIELD: {
+        const auto &hf = static_cast<const physx::PxHeightFieldGeometry &>(geometry);
+        appendValue(key, hf.heightField);
+        appendValue(key, hf.heightScale);
+        appendValue(key, hf.rowScale);
+        appendValue(key, hf.columnScale);
+        appendValue(key, static_cast<uint32_t>(hf.heightFieldFlags));
+        break;
+    }
+    default:
+        Q_UNREACHABLE();
+    }
+}
+
+void QPhysXShapeCache::appendTransformKey(QByteArray &key, const physx::PxTransform &transform)
+{
+    appendValue(key, transform.p.x);
+    appendValue(key, transform.p.y);
+    appendValue(key, transform.p.z);
+    appendValue(key, transform.q.x);
+    appendValue(key, transform.q.y);
+    appendValue(key, transform.q.z);
+    appendValue(key, transform.q.w);
+}
+
+static QByteArray createKey(const physx::PxGeometry &geometry, physx::PxMaterial *material,
+                            const physx::PxFilterData &filterData,
+                            const physx::PxTransform &localPose, bool isTrigger)
+{
+    QByteArray key;
+    key.reserve(128);
+
+    QPhysXShapeCache::appendGeometryKey(key, geometry);
+    appendValue(key, material);
+    appendValue(key, filterData.word0);
+    appendValue(key, filterData.word1);
+    appendValue(key, filterData.word2);
+    appendValue(key, filterData.word3);
+    QPhysXShapeCache::appendTransformKey(key, localPose);
+    appendValue(key, isTrigger);
+
+    return key;
+}
+
+static physx::PxShape *createShape(const physx::PxGeometry &geometry, physx::PxMaterial *material,
+                                   const physx::PxFilterData &filterData,
+                                   const physx::PxTransform &localPose, bool isTrigger,
+                                   bool isExclusive)
+{
+    auto &s_physx = StaticPhysXObjects::getReference();
+    auto *shape = s_physx.physics->createShape(geometry, *material, isExclusive);
+
+    if (isTrigger) {
+        shape->setFlag(physx::PxShapeFlag::eSIMULATION_SHAPE, false);
+        shape->setFlag(physx::PxShapeFlag::eTRIGGER_SHAPE, true);
+    }
+    shape->setSimulationFilterData(filterData);
+    shape->setLocalPose(localPose);
+    return shape;
+}
+
+QPhysXShapeCache::~QPhysXShapeCache()
+{
+    // All bodies should have given their shapes back by now
+    Q_ASSERT(m_shapes.isEmpty());
+    for (auto &entry : m_shapes)
+        entry.shape->release();
+}
+
+physx::PxShape *QPhysXShapeCache::acquire(const physx::PxGeometry &geometry,
+                                          physx::PxMaterial *material,
+                                          const physx::PxFilterData &filterData,
+                                          const physx::PxTransform &localPose, bool isTrigger)
+{
+    const QByteArray key = createKey(geometry, material, filterData, localPose, isTrigger);
+
+    auto it = m_shapes.find(key);
+    if (it != m_shapes.end()) {
+        it->refCount++;
+        return it->shape;
+    }
+
+    constexpr bool isExclusive = false;
+    auto *shape = createShape(geometry, material, filterData, localPose, isTrigger, isExclusive);
+
+    m_shapes.insert(key, { shape, 1 });
+    m_keys.insert(shape, key);
+    return shape;
+}
+
+physx::PxShape *QPhysXShapeCache::createExclusive(const physx::PxGeometry &geometry,
+                                                  physx::PxMaterial *material,
+                                                  const physx::PxFilterData &filterData,
+                                                  const physx::PxTransform &localPose,
+                                                  bool isTrigger)
+{
+    constexpr bool isExclusive = true;
+    return createShape(geometry, material, filterData, localPose, isTrigger, isExclusive);
+}
+
+void QPhysXShapeCache::release(physx::PxShape *shape)
+{
+    if (shape->isExclusive()) {
+        shape->release();
+        return;
+    }
+
+    auto keyIt = m_keys.find(shape);
+    if (keyIt == m_keys.end()) {
+        qWarning() << "QtQuick3DPhysics internal error: releasing a shape that is not cached.";
+        return;
+    }
+
+    auto it = m_shapes.find(*keyIt);
+    Q_ASSERT(it != m_shapes.end());
+    if (--it->refCount > 0)
+        return;
+
+    m_shapes.erase(it);
+    m_keys.erase(keyIt);
+    shape->release();
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,72 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef PHYSXSHAPECACHE_H
+#define PHYSXSHAPECACHE_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "foundation/PxTransform.h"
+#include "qtconfigmacros.h"
+
+#include <QByteArray>
+#include <QHash>
+
+namespace physx {
+class PxGeometry;
+class PxMaterial;
+class PxShape;
+struct PxFilterData;
+}
+
+QT_BEGIN_NAMESPACE
+
+// Hands out non-exclusive PxShapes so that bodies with identical colliders share the same
+// shape. Shapes are keyed by geometry, material, filter data, local pose and trigger flag and
+// are released when the last body using them gives them back.
+//
+// Shared shapes can not be modified while they are attached to an actor, so colliders whose
+// pose or geometry keep changing get an exclusive shape instead, which is updated in place.
+class QPhysXShapeCache
+{
+public:
+    ~QPhysXShapeCache();
+
+    physx::PxShape *acquire(const physx::PxGeometry &geometry, physx::PxMaterial *material,
+                            const physx::PxFilterData &filterData,
+                            const physx::PxTransform &localPose, bool isTrigger);
+    // Creates a shape that belongs to a single body and is not cached
+    static physx::PxShape *createExclusive(const physx::PxGeometry &geometry,
+                                           physx::PxMaterial *material,
+                                           const physx::PxFilterData &filterData,
+                                           const physx::PxTransform &localPose, bool isTrigger);
+    // Gives back a shared shape, or releases an exclusive one
+    void release(physx::PxShape *shape);
+
+    // Appends the parameters that identify a geometry or transform to a cache key
+    static void appendGeometryKey(QByteArray &key, const physx::PxGeometry &geometry);
+    static void appendTransformKey(QByteArray &key, const physx::PxTransform &transform);
+
+private:
+    struct Entry
+    {
+        physx::PxShape *shape = nullptr;
+        int refCount = 0;
+    };
+
+    QHash<QByteArray, Entry> m_shapes;
+    QHash<physx::PxShape *, QByteArray> m_keys;
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -7,6 +7,7 @@
 #include "PxRigidActor.h"
 #include "PxRigidStatic.h"
 
+#include "physxnode/qphysxworld_p.h"
 #include "qphysicsutils_p.h"
 #include "qphysicsworld_p.h"
 #include "qstaticrigidbody_p.h"
@@ -21,6 +22,35 @@ DebugDrawBodyType QPhysXStaticBody::getDebugDrawBodyType()
     return DebugDrawBodyType::Static;
 }
 
+void QPhysXStaticBody::init(QPhysicsWorld *world, QPhysXWorld *physX)
+{
+    QPhysXRigidBody::init(world, physX);
+    physXWorld = physX;
+
+    // Static bodies are only synced when something changed, the shapes and filters are reported
+    // through frontendChanged()
+    auto *staticBody = static_cast<QStaticRigidBody *>(frontendNode);
+    const auto markChanged = [this] { frontendChanged(); };
+    connections.append(QObject::connect(staticBody, &QQuick3DNode::sceneTransformChanged,
+                                        staticBody, markChanged));
+    connections.append(QObject::connect(staticBody,
+                                        &QAbstractPhysicsBody::simulationEnabledChanged,
+                                        staticBody, markChanged));
+
+    // Sync once to pick up the initial state
+    frontendChanged();
+}
+
+void QPhysXStaticBody::cleanup(QPhysXWorld *physX)
+{
+    for (const auto &connection : std::as_const(connections))
+        QObject::disconnect(connection);
+    connections.clear();
+    physX->dirtyBodies.remove(this);
+    physXWorld = nullptr;
+    QPhysXRigidBody::cleanup(physX);
+}
+
 void QPhysXStaticBody::sync(float deltaTime, QHash<QQuick3DNode *, QMatrix4x4> &transformCache)
 {
     auto *staticBody = static_cast<QStaticRigidBody *>(frontendNode);
@@ -33,7 +63,7 @@ void QPhysXStaticBody::sync(float deltaTime, QHash<QQuick3DNode *, QMatrix4x4> &
         actor->setGlobalPose(poseNew);
 
     const bool disabledPrevious = actor->getActorFlags() & physx::PxActorFlag::eDISABLE_SIMULATION;
-    const bool disabled = !staticBody->simulationEnabled();
+    const bool disabled = !staticBody->simulationEnabled() || hasPendingShapes;
     if (disabled != disabledPrevious) {
         actor->setActorFlag(physx::PxActorFlag::eDISABLE_SIMULATION, disabled);
     }
@@ -49,4 +79,15 @@ void QPhysXStaticBody::createActor(QPhysXWorld * /*physX*/)
     actor = s_physx.physics->createRigidStatic(trf);
 }
 
+bool QPhysXStaticBody::isSyncedEveryFrame() const
+{
+    return false;
+}
+
+void QPhysXStaticBody::frontendChanged()
+{
+    if (physXWorld)
+        physXWorld->dirtyBodies.insert(this);
+}
+
 QT_END_NAMESPACE
@@ -18,6 +18,9 @@
 #include "physxnode/qphysxrigidbody_p.h"
 #include "qtconfigmacros.h"
 
+#include <QList>
+#include <QMetaObject>
+
 QT_BEGIN_NAMESPACE
 class QStaticRigidBody;
 
@@ -27,8 +30,15 @@ public:
     QPhysXStaticBody(QStaticRigidBody *frontEnd);
 
     DebugDrawBodyType getDebugDrawBodyType() override;
+    void init(QPhysicsWorld *world, QPhysXWorld *physX) override;
+    void cleanup(QPhysXWorld *physX) override;
     void sync(float deltaTime, QHash<QQuick3DNode *, QMatrix4x4> &transformCache) override;
     void createActor(QPhysXWorld *physX) override;
+    bool isSyncedEveryFrame() const override;
+    void frontendChanged() override;
+
+    QPhysXWorld *physXWorld = nullptr;
+    QList<QMetaObject::Connection> connections;
 };
 
 QT_END_NAMESPACE
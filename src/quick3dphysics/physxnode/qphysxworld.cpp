@@ -12,14 +12,22 @@
 #include "PxPhysicsVersion.h"
 #include "PxRigidActor.h"
 #include "PxScene.h"
+#include "PxContactModifyCallback.h"
 #include "PxSimulationEventCallback.h"
 
+#include "physxnode/qphysxdynamicbody_p.h"
 #include "qabstractphysicsnode_p.h"
+#include "qcollisionassets_p.h"
+#include "qphysicsmeshutils_p_p.h"
+#include "qphysicscontactmodifier_p.h"
 #include "qphysicsutils_p.h"
 #include "qphysicsworld_p.h"
 #include "qstaticphysxobjects_p.h"
 #include "qtriggerbody_p.h"
 
+#include <QtCore/QThreadPool>
+#include <QtCore/QVarLengthArray>
+
 QT_BEGIN_NAMESPACE
 
 class SimulationEventCallback : public physx::PxSimulationEventCallback
@@ -73,8 +81,14 @@ public:
 
     void onConstraintBreak(physx::PxConstraintInfo * /*constraints*/,
                            physx::PxU32 /*count*/) override {};
-    void onWake(physx::PxActor ** /*actors*/, physx::PxU32 /*count*/) override {};
-    void onSleep(physx::PxActor ** /*actors*/, physx::PxU32 /*count*/) override {};
+    void onWake(physx::PxActor **actors, physx::PxU32 count) override
+    {
+        updateSleepState(actors, count, false);
+    }
+    void onSleep(physx::PxActor **actors, physx::PxU32 count) override
+    {
+        updateSleepState(actors, count, true);
+    }
     void onContact(const physx::PxContactPairHeader &pairHeader, const physx::PxContactPair *pairs,
                    physx::PxU32 nbPairs) override
     {
@@ -137,11 +151,45 @@ public:
             }
         }
     };
-    void onAdvance(const physx::PxRigidBody *const * /*bodyBuffer*/,
-                   const physx::PxTransform * /*poseBuffer*/,
-                   const physx::PxU32 /*count*/) override {};
+    void onAdvance(const physx::PxRigidBody *const *bodyBuffer,
+                   const physx::PxTransform *poseBuffer, const physx::PxU32 count) override
+    {
+        // Called from a simulation task while the step is still running. The actors are only
+        // released by the GUI thread in between steps so reading userData is safe here.
+        auto &posePreviews = world->m_physx->posePreviews;
+        auto &buffer = posePreviews.writeBuffer();
+        buffer.reserve(count);
+        for (physx::PxU32 i = 0; i < count; i++) {
+            auto *node = static_cast<QAbstractPhysicsNode *>(bodyBuffer[i]->userData);
+            if (node)
+                buffer.push_back({ node, poseBuffer[i] });
+        }
+        posePreviews.publish();
+
+        QMetaObject::invokeMethod(world, &QPhysicsWorld::updatePosePreviews,
+                                  Qt::QueuedConnection);
+    }
 
 private:
+    void updateSleepState(physx::PxActor **actors, physx::PxU32 count, bool sleeping)
+    {
+        QMutexLocker locker(&world->m_removedPhysicsNodesMutex);
+
+        for (physx::PxU32 i = 0; i < count; i++) {
+            QAbstractPhysicsNode *node = static_cast<QAbstractPhysicsNode *>(actors[i]->userData);
+            if (!node || world->isNodeRemoved(node) || !node->m_backendObject)
+                continue;
+
+            // Only dynamic bodies request sleep notifications
+            auto *body = static_cast<QPhysXDynamicBody *>(node->m_backendObject);
+            if (sleeping)
+                world->m_physx->wokenBodies.remove(body);
+            else
+                world->m_physx->wokenBodies.insert(body);
+            world->m_physx->sleepStateChangedBodies.push_back(body);
+        }
+    }
+
     QPhysicsWorld *world = nullptr;
 };
 
@@ -151,12 +199,46 @@ static constexpr bool isBitSet(quint32 value, quint32 position)
     return value & (1 << (position));
 }
 
+class ContactModifyCallback : public physx::PxContactModifyCallback
+{
+public:
+    ContactModifyCallback(QPhysXWorld *physXIn) : physX(physXIn) {};
+    virtual ~ContactModifyCallback() = default;
+
+    void onContactModify(physx::PxContactModifyPair *const pairs, physx::PxU32 count) override
+    {
+        for (physx::PxU32 i = 0; i < count; i++) {
+            auto &pair = pairs[i];
+            for (int shapeIndex = 0; shapeIndex < 2; shapeIndex++) {
+                const quint32 group = pair.shape[shapeIndex]->getSimulationFilterData().word0;
+                if (group >= 32)
+                    continue;
+                if (auto *modifier = physX->contactModifiers[group])
+                    modifier->modifyContacts(pair, shapeIndex);
+            }
+        }
+    }
+
+private:
+    QPhysXWorld *physX = nullptr;
+};
+
+// The constant block holds a mask of the filter groups that want their contacts modified
+static bool wantsContactModification(quint32 id0, quint32 id1, const void *constantBlock,
+                                     physx::PxU32 constantBlockSize)
+{
+    if (constantBlockSize != sizeof(quint32))
+        return false;
+    const quint32 modifyMask = *static_cast<const quint32 *>(constantBlock);
+    return (id0 < 32 && isBitSet(modifyMask, id0)) || (id1 < 32 && isBitSet(modifyMask, id1));
+}
+
 static physx::PxFilterFlags
 contactReportFilterShader(physx::PxFilterObjectAttributes /*attributes0*/,
                           physx::PxFilterData filterData0,
                           physx::PxFilterObjectAttributes /*attributes1*/,
                           physx::PxFilterData filterData1, physx::PxPairFlags &pairFlags,
-                          const void * /*constantBlock*/, physx::PxU32 /*constantBlockSize*/)
+                          const void *constantBlock, physx::PxU32 constantBlockSize)
 {
     // First word is id, second is collision mask
     const quint32 id0 = filterData0.word0;
@@ -182,15 +264,17 @@ contactReportFilterShader(physx::PxFilterObjectAttributes /*attributes0*/,
     const auto notifyContactFlags = physx::PxPairFlag::eNOTIFY_CONTACT_POINTS;
 
     pairFlags = defaultCollisonFlags | notifyTouchFlags | notifyContactFlags;
+    if (wantsContactModification(id0, id1, constantBlock, constantBlockSize))
+        pairFlags |= physx::PxPairFlag::eMODIFY_CONTACTS;
     return physx::PxFilterFlag::eDEFAULT;
 }
 
 static physx::PxFilterFlags
 contactReportFilterShaderCCD(physx::PxFilterObjectAttributes /*attributes0*/,
-                             physx::PxFilterData /*filterData0*/,
+                             physx::PxFilterData filterData0,
                              physx::PxFilterObjectAttributes /*attributes1*/,
-                             physx::PxFilterData /*filterData1*/, physx::PxPairFlags &pairFlags,
-                             const void * /*constantBlock*/, physx::PxU32 /*constantBlockSize*/)
+                             physx::PxFilterData filterData1, physx::PxPairFlags &pairFlags,
+                             const void *constantBlock, physx::PxU32 constantBlockSize)
 {
     // Makes objects collide
     const auto defaultCollisonFlags = physx::PxPairFlag::eSOLVE_CONTACT
@@ -204,6 +288,9 @@ contactReportFilterShaderCCD(physx::PxFilterObjectAttributes /*attributes0*/,
     const auto notifyContactFlags = physx::PxPairFlag::eNOTIFY_CONTACT_POINTS;
 
     pairFlags = defaultCollisonFlags | notifyTouchFlags | notifyContactFlags;
+    if (wantsContactModification(filterData0.word0, filterData1.word0, constantBlock,
+                                 constantBlockSize))
+        pairFlags |= physx::PxPairFlag::eMODIFY_CONTACTS;
     return physx::PxFilterFlag::eDEFAULT;
 }
 
@@ -234,33 +321,54 @@ void QPhysXWorld::createWorld()
     s_physx.pvd->connect(*m_physx->transport, physx::PxPvdInstrumentationFlag::eALL);
 #endif
 
-    // FIXME: does the tolerance matter?
+    // The tolerance scale only sets the convex hull area test, which is not enabled, so the
+    // default scale is used. The other parameters are set by QPhysicsWorld from its properties.
     s_physx.cooking = PxCreateCooking(PX_PHYSICS_VERSION, *s_physx.foundation,
                                       physx::PxCookingParams(physx::PxTolerancesScale()));
-
 }
 
 void QPhysXWorld::deleteWorld()
 {
     auto &s_physx = StaticPhysXObjects::getReference();
+    // The cached mass properties hold references to meshes that must go before PhysX
+    massPropertiesCache.clear();
+    actorPool.clear();
     s_physx.foundationRefCount--;
     if (s_physx.foundationRefCount == 0) {
+        // Cooking jobs cook with the foundation and create meshes with the physics, so they must
+        // be done before either is released. Finished jobs that were not delivered yet belong to
+        // the old generation and drop their result, even if a new world exists by the time they
+        // are delivered.
+        if (s_physx.cookingPool) {
+            s_physx.cookingPool->waitForDone();
+            delete s_physx.cookingPool;
+            s_physx.cookingPool = nullptr;
+        }
+
         PHYSX_RELEASE(controllerManager);
         PHYSX_RELEASE(scene);
         PHYSX_RELEASE(s_physx.dispatcher);
         PHYSX_RELEASE(s_physx.cooking);
         PHYSX_RELEASE(s_physx.transport);
         PHYSX_RELEASE(s_physx.pvd);
+        QQuick3DPhysicsMeshManager::releaseGeometryMeshes();
         PHYSX_RELEASE(s_physx.physics);
+        s_physx.physicsGeneration++;
+        // The objects in the collision asset collections went with the physics
+        QCollisionAssets::releaseCollections();
         PHYSX_RELEASE(s_physx.foundation);
 
         delete callback;
         callback = nullptr;
+        delete contactModifyCallback;
+        contactModifyCallback = nullptr;
         s_physx.foundationCreated = false;
         s_physx.physicsCreated = false;
     } else {
         delete callback;
         callback = nullptr;
+        delete contactModifyCallback;
+        contactModifyCallback = nullptr;
         PHYSX_RELEASE(controllerManager);
         PHYSX_RELEASE(scene);
     }
@@ -288,10 +396,12 @@ void QPhysXWorld::createScene(float typicalLength, float typicalSpeed, const QVe
             qFatal("PxCreatePhysics failed!");
 
         s_physx.dispatcher = physx::PxDefaultCpuDispatcherCreate(numThreads);
+        s_physx.cookingPool = new QThreadPool;
         s_physx.physicsCreated = true;
     }
 
     callback = new SimulationEventCallback(physicsWorld);
+    contactModifyCallback = new ContactModifyCallback(this);
 
     physx::PxSceneDesc sceneDesc(scale);
     sceneDesc.gravity = QPhysicsUtils::toPhysXType(gravity);
@@ -305,6 +415,9 @@ void QPhysXWorld::createScene(float typicalLength, float typicalSpeed, const QVe
     }
     sceneDesc.solverType = physx::PxSolverType::eTGS;
     sceneDesc.simulationEventCallback = callback;
+    sceneDesc.contactModifyCallback = contactModifyCallback;
+    sceneDesc.filterShaderData = &contactModifierMask;
+    sceneDesc.filterShaderDataSize = sizeof(contactModifierMask);
 
     if (physicsWorld->reportKinematicKinematicCollisions())
         sceneDesc.kineKineFilteringMode = physx::PxPairFilteringMode::eKEEP;
@@ -314,4 +427,55 @@ void QPhysXWorld::createScene(float typicalLength, float typicalSpeed, const QVe
     scene = s_physx.physics->createScene(sceneDesc);
 }
 
+void QPhysXWorld::setContactModifiers(const std::array<QPhysicsContactModifier *, 32> &modifiers)
+{
+    contactModifiers = modifiers;
+    contactModifierMask = 0;
+    for (quint32 group = 0; group < modifiers.size(); group++) {
+        if (modifiers[group])
+            contactModifierMask |= 1u << group;
+    }
+
+    if (!scene)
+        return;
+
+    scene->setFilterShaderData(&contactModifierMask, sizeof(contactModifierMask));
+
+    // The existing pairs have to be filtered again to pick up the new mask
+    const auto actorTypes =
+            physx::PxActorTypeFlag::eRIGID_STATIC | physx::PxActorTypeFlag::eRIGID_DYNAMIC;
+    QVarLengthArray<physx::PxActor *> actors(scene->getNbActors(actorTypes));
+    scene->getActors(actorTypes, actors.data(), actors.size());
+    for (auto *actor : actors)
+        scene->resetFiltering(*actor);
+}
+
+void QPhysXWorld::addPendingActors()
+{
+    if (pendingActors.isEmpty())
+        return;
+
+    // Adding all actors at once lets PhysX update the broad phase and the pruning structures
+    // in bulk instead of once per actor.
+    scene->addActors(pendingActors.constData(), physx::PxU32(pendingActors.size()));
+    pendingActors.clear();
+}
+
+void QPhysXWorld::removePendingActors()
+{
+    if (removedActors.isEmpty())
+        return;
+
+    // Removing the actors in bulk before releasing them saves PhysX from updating the broad
+    // phase and the pruning structures once per released actor.
+    constexpr bool wakeOnLostTouch = true;
+    scene->removeActors(removedActors.constData(), physx::PxU32(removedActors.size()),
+                        wakeOnLostTouch);
+    removedActors.clear();
+
+    for (auto *actor : std::as_const(releasedActors))
+        actor->release();
+    releasedActors.clear();
+}
+
 QT_END_NAMESPACE
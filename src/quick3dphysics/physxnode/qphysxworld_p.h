@@ -15,9 +15,21 @@
 // We mean it.
 //
 
+#include "foundation/PxTransform.h"
+#include "physxnode/qphysxactorpool_p.h"
+#include "physxnode/qphysxmasspropertiescache_p.h"
+#include "physxnode/qphysxmaterialregistry_p.h"
+#include "physxnode/qphysxshapecache_p.h"
 #include "qtconfigmacros.h"
 
+#include <QtCore/QAtomicInt>
+#include <QtCore/QList>
+#include <QtCore/QSet>
+
+#include <array>
+
 namespace physx {
+class PxActor;
 class PxScene;
 class PxControllerManager;
 }
@@ -25,9 +37,52 @@ class PxControllerManager;
 QT_BEGIN_NAMESPACE
 
 class SimulationEventCallback;
+class ContactModifyCallback;
+class QPhysicsContactModifier;
+class QAbstractPhysicsNode;
 class QPhysicsWorld;
+class QPhysXDynamicBody;
 class QVector3D;
 
+struct PosePreview
+{
+    QAbstractPhysicsNode *node = nullptr;
+    physx::PxTransform pose;
+};
+
+// Lock-free single producer, single consumer triple buffer. The simulation publishes the poses
+// reported by onAdvance and the GUI thread picks up the latest ones while the step is running.
+class PosePreviewBuffer
+{
+public:
+    QList<PosePreview> &writeBuffer() { return m_buffers[m_writeIndex]; }
+
+    void publish()
+    {
+        const int previous = m_shared.fetchAndStoreRelease(m_writeIndex | FreshBit);
+        m_writeIndex = previous & IndexMask;
+        m_buffers[m_writeIndex].clear();
+    }
+
+    const QList<PosePreview> *consume()
+    {
+        if (!(m_shared.loadAcquire() & FreshBit))
+            return nullptr;
+        const int previous = m_shared.fetchAndStoreAcquire(m_readIndex);
+        m_readIndex = previous & IndexMask;
+        return &m_buffers[m_readIndex];
+    }
+
+private:
+    static constexpr int IndexMask = 0x3;
+    static constexpr int FreshBit = 0x4;
+
+    QList<PosePreview> m_buffers[3];
+    QAtomicInt m_shared = 1;
+    int m_writeIndex = 0;
+    int m_readIndex = 2;
+};
+
 class QPhysXWorld
 {
 public:
@@ -35,12 +90,45 @@ public:
     void deleteWorld();
     void createScene(float typicalLength, float typicalSpeed, const QVector3D &gravity,
                      bool enableCCD, QPhysicsWorld *physicsWorld, unsigned int numThreads);
+    void setContactModifiers(const std::array<QPhysicsContactModifier *, 32> &modifiers);
+    void addPendingActors();
+    void removePendingActors();
 
     // variables unique to each world/scene
     physx::PxControllerManager *controllerManager = nullptr;
     SimulationEventCallback *callback = nullptr;
+    ContactModifyCallback *contactModifyCallback = nullptr;
     physx::PxScene *scene = nullptr;
     bool isRunning = false;
+    // Actors of the backends created this frame, added to the scene in one call
+    QList<physx::PxActor *> pendingActors;
+    // Actors of the backends cleaned up this frame, removed from the scene in one call
+    QList<physx::PxActor *> removedActors;
+    // The removed actors that are released afterwards, the others are parked in actorPool
+    QList<physx::PxActor *> releasedActors;
+
+    // Bodies that are not synced every frame and changed since the last frame
+    QSet<QAbstractPhysXNode *> dirtyBodies;
+    // Dynamic bodies whose last sleep notification was onWake. A body that is added to the scene
+    // awake gets an onWake from the next simulation step, so it is in the set from then on, but
+    // not in between adding it and fetching the results of that step.
+    QSet<QPhysXDynamicBody *> wokenBodies;
+    // Dynamic bodies that fell asleep or woke up during the last simulation step
+    QList<QPhysXDynamicBody *> sleepStateChangedBodies;
+    // Poses of bodies with eENABLE_POSE_INTEGRATION_PREVIEW, published by onAdvance
+    PosePreviewBuffer posePreviews;
+    // Contact modifiers indexed by filter group, only changed in between simulation steps
+    std::array<QPhysicsContactModifier *, 32> contactModifiers {};
+    // Bit mask of the filter groups that have a contact modifier, passed to the filter shader
+    quint32 contactModifierMask = 0;
+    // PxMaterials shared by all bodies referencing the same QPhysicsMaterial
+    QPhysXMaterialRegistry materialRegistry;
+    // Non-exclusive shapes shared by all bodies in the world
+    QPhysXShapeCache shapeCache;
+    // Actors of destroyed dynamic bodies kept for reuse, see PhysicsWorld.dynamicBodyPoolSize
+    QPhysXActorPool actorPool { shapeCache };
+    // Mass properties of the shape sets used by the dynamic bodies
+    QPhysXMassPropertiesCache massPropertiesCache;
 };
 
 QT_END_NAMESPACE
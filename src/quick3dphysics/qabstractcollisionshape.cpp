@@ -7,6 +7,8 @@
 
 #include "qphysicsworld_p.h"
 
+#include "geometry/PxGeometryHelpers.h"
+
 QT_BEGIN_NAMESPACE
 
 /*!
@@ -30,10 +32,21 @@ QT_BEGIN_NAMESPACE
     Default value: \c{false}
 */
 
-QAbstractCollisionShape::QAbstractCollisionShape(QQuick3DNode *parent) : QQuick3DNode(parent)
+struct QAbstractCollisionShape::PhysXGeometryStorage
+{
+    physx::PxGeometryHolder holder;
+    bool isSet = false;
+};
+
+QAbstractCollisionShape::QAbstractCollisionShape(QQuick3DNode *parent)
+    : QQuick3DNode(parent), m_physXGeometry(std::make_unique<PhysXGeometryStorage>())
 {
     connect(this, &QQuick3DNode::sceneScaleChanged, this,
             &QAbstractCollisionShape::handleScaleChange);
+    connect(this, &QQuick3DNode::positionChanged, this,
+            &QAbstractCollisionShape::handlePoseChange);
+    connect(this, &QQuick3DNode::rotationChanged, this,
+            &QAbstractCollisionShape::handlePoseChange);
 }
 
 QAbstractCollisionShape::~QAbstractCollisionShape() = default;
@@ -55,6 +68,29 @@ void QAbstractCollisionShape::setEnableDebugDraw(bool enableDebugDraw)
     emit enableDebugDrawChanged(m_enableDebugDraw);
 }
 
+QList<physx::PxGeometry *> QAbstractCollisionShape::getPhysXGeometries()
+{
+    if (auto *geometry = getPhysXGeometry())
+        return { geometry };
+    return {};
+}
+
+physx::PxGeometry *QAbstractCollisionShape::physXGeometry()
+{
+    return m_physXGeometry->isSet ? &m_physXGeometry->holder.any() : nullptr;
+}
+
+void QAbstractCollisionShape::setPhysXGeometry(const physx::PxGeometry &geometry)
+{
+    m_physXGeometry->holder.storeAny(geometry);
+    m_physXGeometry->isSet = true;
+}
+
+void QAbstractCollisionShape::resetPhysXGeometry()
+{
+    m_physXGeometry->isSet = false;
+}
+
 void QAbstractCollisionShape::handleScaleChange()
 {
     auto newScale = sceneScale();
@@ -65,4 +101,10 @@ void QAbstractCollisionShape::handleScaleChange()
     }
 }
 
+void QAbstractCollisionShape::handlePoseChange()
+{
+    // Lets the owning body update the local pose of the shape without polling every frame
+    emit poseChanged(this);
+}
+
 QT_END_NAMESPACE
@@ -19,6 +19,8 @@
 #include <QtQuick3D/private/qquick3dnode_p.h>
 #include <QtQml/QQmlEngine>
 
+#include <memory>
+
 namespace physx {
 class PxGeometry;
 }
@@ -37,6 +39,9 @@ public:
     virtual ~QAbstractCollisionShape();
 
     virtual physx::PxGeometry *getPhysXGeometry() = 0;
+    // Shapes made of several PhysX geometries return all of them, one PhysX shape is created
+    // for each
+    virtual QList<physx::PxGeometry *> getPhysXGeometries();
     bool enableDebugDraw() const;
 
     virtual bool isStaticShape() const = 0;
@@ -47,15 +52,25 @@ public slots:
 signals:
     void enableDebugDrawChanged(bool enableDebugDraw);
     void needsRebuild(QObject *);
+    void poseChanged(QObject *);
 
 protected:
+    physx::PxGeometry *physXGeometry();
+    void setPhysXGeometry(const physx::PxGeometry &geometry);
+    void resetPhysXGeometry();
+
     bool m_scaleDirty = true;
     QVector3D m_prevScale;
 
 private slots:
     void handleScaleChange();
+    void handlePoseChange();
 
 private:
+    // Holds the geometry by value, so geometry updates do not allocate. It is defined in the .cpp
+    // file so that this header does not need the PhysX headers.
+    struct PhysXGeometryStorage;
+    std::unique_ptr<PhysXGeometryStorage> m_physXGeometry;
     bool m_enableDebugDraw = false;
 };
 
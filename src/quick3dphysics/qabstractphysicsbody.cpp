@@ -47,6 +47,7 @@ void QAbstractPhysicsBody::setPhysicsMaterial(QPhysicsMaterial *newPhysicsMateri
     if (m_physicsMaterial == newPhysicsMaterial)
         return;
     m_physicsMaterial = newPhysicsMaterial;
+    markMaterialDirty();
     emit physicsMaterialChanged();
 }
 
@@ -6,6 +6,7 @@
 #include <foundation/PxTransform.h>
 
 #include "qphysicsworld_p.h"
+#include "physxnode/qabstractphysxnode_p.h"
 QT_BEGIN_NAMESPACE
 
 /*!
@@ -228,12 +229,42 @@ void QAbstractPhysicsNode::registerContact(QAbstractPhysicsNode *body,
 
 void QAbstractPhysicsNode::onShapeDestroyed(QObject *object)
 {
-    m_collisionShapes.removeAll(static_cast<QAbstractCollisionShape *>(object));
+    auto *shape = static_cast<QAbstractCollisionShape *>(object);
+    m_collisionShapes.removeAll(shape);
+    m_dirtyCollisionShapes.remove(shape);
+    markShapesDirty();
 }
 
-void QAbstractPhysicsNode::onShapeNeedsRebuild(QObject * /*object*/)
+void QAbstractPhysicsNode::onShapeNeedsRebuild(QObject *object)
+{
+    m_dirtyCollisionShapes.insert(static_cast<QAbstractCollisionShape *>(object));
+    markShapesDirty();
+}
+
+void QAbstractPhysicsNode::onShapePoseChanged(QObject * /*object*/)
+{
+    markShapesDirty();
+}
+
+void QAbstractPhysicsNode::markShapesDirty()
 {
     m_shapesDirty = true;
+    if (m_backendObject)
+        m_backendObject->frontendChanged();
+}
+
+void QAbstractPhysicsNode::markFiltersDirty()
+{
+    m_filtersDirty = true;
+    if (m_backendObject)
+        m_backendObject->frontendChanged();
+}
+
+void QAbstractPhysicsNode::markMaterialDirty()
+{
+    m_materialDirty = true;
+    if (m_backendObject)
+        m_backendObject->frontendChanged();
 }
 
 void QAbstractPhysicsNode::qmlAppendShape(QQmlListProperty<QAbstractCollisionShape> *list,
@@ -243,6 +274,8 @@ void QAbstractPhysicsNode::qmlAppendShape(QQmlListProperty<QAbstractCollisionSha
         return;
     QAbstractPhysicsNode *self = static_cast<QAbstractPhysicsNode *>(list->object);
     self->m_collisionShapes.push_back(shape);
+    self->m_dirtyCollisionShapes.insert(shape);
+    self->markShapesDirty();
     self->m_hasStaticShapes = self->m_hasStaticShapes || shape->isStaticShape();
 
     if (shape->parentItem() == nullptr) {
@@ -266,6 +299,8 @@ void QAbstractPhysicsNode::qmlAppendShape(QQmlListProperty<QAbstractCollisionSha
     // Connect to rebuild signal
     connect(shape, &QAbstractCollisionShape::needsRebuild, self,
             &QAbstractPhysicsNode::onShapeNeedsRebuild);
+    connect(shape, &QAbstractCollisionShape::poseChanged, self,
+            &QAbstractPhysicsNode::onShapePoseChanged);
 }
 
 QAbstractCollisionShape *
@@ -292,6 +327,8 @@ void QAbstractPhysicsNode::qmlClearShapes(QQmlListProperty<QAbstractCollisionSha
     for (auto shape : std::as_const(self->m_collisionShapes))
         shape->disconnect(self);
     self->m_collisionShapes.clear();
+    self->m_dirtyCollisionShapes.clear();
+    self->markShapesDirty();
 }
 
 int QAbstractPhysicsNode::filterGroup() const
@@ -304,7 +341,7 @@ void QAbstractPhysicsNode::setfilterGroup(int newfilterGroup)
     if (m_filterGroup == newfilterGroup)
         return;
     m_filterGroup = newfilterGroup;
-    m_filtersDirty = true;
+    markFiltersDirty();
     emit filterGroupChanged();
 }
 
@@ -318,7 +355,7 @@ void QAbstractPhysicsNode::setFilterIgnoreGroups(int newFilterIgnoreGroups)
     if (m_filterIgnoreGroups == newFilterIgnoreGroups)
         return;
     m_filterIgnoreGroups = newFilterIgnoreGroups;
-    m_filtersDirty = true;
+    markFiltersDirty();
     emit filterIgnoreGroupsChanged();
 }
 
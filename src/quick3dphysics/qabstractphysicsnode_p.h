@@ -19,6 +19,7 @@
 #include <QtQuick3D/private/qquick3dnode_p.h>
 #include <QtQml/QQmlEngine>
 #include <QtQml/QQmlListProperty>
+#include <QtCore/QSet>
 #include <QtQuick3DPhysics/private/qabstractcollisionshape_p.h>
 
 namespace physx {
@@ -84,9 +85,14 @@ public:
     Q_REVISION(6, 7) int filterIgnoreGroups() const;
     Q_REVISION(6, 7) void setFilterIgnoreGroups(int newFilterIgnoreGroups);
 
+protected:
+    // Also tells the backend, see markShapesDirty()
+    void markMaterialDirty();
+
 private Q_SLOTS:
     void onShapeDestroyed(QObject *object);
     void onShapeNeedsRebuild(QObject *object);
+    void onShapePoseChanged(QObject *object);
 
 Q_SIGNALS:
     void bodyContact(QAbstractPhysicsNode *body, const QVector<QVector3D> &positions,
@@ -108,7 +114,13 @@ private:
     static qsizetype qmlShapeCount(QQmlListProperty<QAbstractCollisionShape> *list);
     static void qmlClearShapes(QQmlListProperty<QAbstractCollisionShape> *list);
 
+    // Also tell the backend, which may not check the dirty flags every frame
+    void markShapesDirty();
+    void markFiltersDirty();
+
     QVector<QAbstractCollisionShape *> m_collisionShapes;
+    // Shapes whose geometry changed since the backend last picked them up
+    QSet<QAbstractCollisionShape *> m_dirtyCollisionShapes;
     bool m_shapesDirty = false;
     bool m_sendContactReports = false;
     bool m_receiveContactReports = false;
@@ -118,10 +130,15 @@ private:
     int m_filterGroup = 0;
     int m_filterIgnoreGroups = 0;
     bool m_filtersDirty = false;
+    // The physics material was replaced since the backend last picked it up
+    bool m_materialDirty = false;
+    // Baked into a StaticCollisionBatch, so no backend of its own is created
+    bool m_isBatched = false;
 
     friend class QAbstractPhysXNode;
     friend class QPhysicsWorld; // for register/deregister TODO: cleaner mechanism
     friend class SimulationEventCallback;
+    friend class QStaticCollisionBatch;
     QAbstractPhysXNode *m_backendObject = nullptr;
 };
 
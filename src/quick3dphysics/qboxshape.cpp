@@ -32,10 +32,7 @@ QT_BEGIN_NAMESPACE
 */
 
 QBoxShape::QBoxShape() = default;
-QBoxShape::~QBoxShape()
-{
-    delete m_physXGeometry;
-}
+QBoxShape::~QBoxShape() = default;
 
 QVector3D QBoxShape::extents() const
 {
@@ -44,10 +41,10 @@ QVector3D QBoxShape::extents() const
 
 physx::PxGeometry *QBoxShape::getPhysXGeometry()
 {
-    if (!m_physXGeometry || m_scaleDirty) {
+    if (!physXGeometry() || m_scaleDirty) {
         updatePhysXGeometry();
     }
-    return m_physXGeometry;
+    return physXGeometry();
 }
 
 void QBoxShape::setExtents(QVector3D extents)
@@ -64,9 +61,8 @@ void QBoxShape::setExtents(QVector3D extents)
 
 void QBoxShape::updatePhysXGeometry()
 {
-    delete m_physXGeometry;
     const QVector3D half = m_extents * sceneScale() * 0.5f;
-    m_physXGeometry = new physx::PxBoxGeometry(half.x(), half.y(), half.z());
+    setPhysXGeometry(physx::PxBoxGeometry(half.x(), half.y(), half.z()));
     m_scaleDirty = false;
 }
 
@@ -21,10 +21,6 @@
 #include <QtGui/QVector3D>
 #include <QtQml/QQmlEngine>
 
-namespace physx {
-class PxBoxGeometry;
-}
-
 QT_BEGIN_NAMESPACE
 
 class Q_QUICK3DPHYSICS_EXPORT QBoxShape : public QAbstractCollisionShape
@@ -50,7 +46,6 @@ signals:
 private:
     void updatePhysXGeometry();
 
-    physx::PxBoxGeometry *m_physXGeometry = nullptr;
     QVector3D m_extents = QVector3D(100, 100, 100);
 };
 
@@ -3,182 +3,729 @@
 
 #include "qcacheutils_p.h"
 
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QLockFile>
+#include <QMutex>
+#include <QSaveFile>
+#include <QSet>
+#include <QThreadPool>
 #include <QtQml/QQmlFile>
 #include <extensions/PxExtensionsAPI.h>
+#include "cooking/PxCooking.h"
+#include "qcollisionassets_p.h"
 #include "qphysicsworld_p.h"
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 namespace QCacheUtils {
 
-enum class CacheGeometry { TriangleMesh, ConvexMesh, HeightField };
+enum class CacheGeometry { TriangleMesh, ConvexMesh, HeightField, ConvexDecomposition };
 
 static QString MESH_CACHE_PATH = qEnvironmentVariable("QT_PHYSICS_CACHE_PATH");
 
-static QString getCachedFilename(const QString &filePath, CacheGeometry geom)
+// Maximum total size of the cache entries in megabytes, the least recently used entries are
+// removed when it is exceeded
+static const qint64 MESH_CACHE_MAX_SIZE =
+        qEnvironmentVariableIsSet("QT_PHYSICS_CACHE_MAX_SIZE")
+        ? qEnvironmentVariableIntValue("QT_PHYSICS_CACHE_MAX_SIZE") * qint64(1024 * 1024)
+        : qint64(512) * 1024 * 1024;
+
+// Every cache entry starts with this header, followed by the cooked PhysX data
+struct CacheHeader
+{
+    quint32 magic;
+    quint32 version;
+    qint64 sourceSize;
+    qint64 sourceModified;
+    quint64 sourceHash;
+};
+
+static constexpr quint32 CACHE_MAGIC = 0x43585051; // "QPXC"
+static constexpr quint32 CACHE_VERSION = 1;
+static constexpr char CACHE_INDEX_HEADER[] = "QtQuick3DPhysics cache index 1";
+
+static void saveCacheIndex();
+
+// The index records the size and the last use of every entry in the cache directory. A key
+// that is not in the index is a miss without touching the file system.
+//
+// Changes are kept in memory and written once when the application exits. Several processes can
+// share a cache directory, so the index on disk is merged with the changes of this process under
+// a lock file before it is written.
+class CacheIndex
+{
+public:
+    bool contains(const QByteArray &key)
+    {
+        QMutexLocker locker(&m_mutex);
+        load();
+        return m_entries.contains(key);
+    }
+
+    void touch(const QByteArray &key)
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_entries.find(key);
+        if (it == m_entries.end())
+            return;
+        it->lastUsed = QDateTime::currentMSecsSinceEpoch();
+        m_dirty = true;
+    }
+
+    void insert(const QByteArray &key, const QString &fileName, qint64 size)
+    {
+        QMutexLocker locker(&m_mutex);
+        load();
+        auto &entry = m_entries[key];
+        m_totalSize += size - entry.size;
+        entry = { fileName, size, QDateTime::currentMSecsSinceEpoch() };
+        m_inserted.insert(key);
+        m_removed.remove(key);
+        m_dirty = true;
+        evict();
+    }
+
+    void remove(const QByteArray &key)
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_entries.find(key);
+        if (it == m_entries.end())
+            return;
+        removeEntry(it);
+        m_dirty = true;
+    }
+
+    void saveIfDirty()
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_dirty)
+            save();
+    }
+
+private:
+    struct Entry
+    {
+        QString fileName;
+        qint64 size = 0;
+        qint64 lastUsed = 0;
+    };
+
+    static QString indexPath() { return QDir(MESH_CACHE_PATH).filePath(QStringLiteral("index")); }
+
+    static QHash<QByteArray, Entry> readIndex()
+    {
+        QHash<QByteArray, Entry> entries;
+        QFile file(indexPath());
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+            return entries;
+        if (file.readLine().trimmed() != CACHE_INDEX_HEADER)
+            return entries;
+
+        while (!file.atEnd()) {
+            const QList<QByteArray> fields = file.readLine().trimmed().split(' ');
+            if (fields.size() != 4)
+                continue;
+            entries.insert(fields[0], { QString::fromUtf8(fields[1]), fields[2].toLongLong(),
+                                        fields[3].toLongLong() });
+        }
+        return entries;
+    }
+
+    void load()
+    {
+        if (m_loaded)
+            return;
+        m_loaded = true;
+
+        // Write back the changes and the last use of the entries read during this run
+        qAddPostRoutine(saveCacheIndex);
+
+        m_entries = readIndex();
+        for (const auto &entry : std::as_const(m_entries))
+            m_totalSize += entry.size;
+    }
+
+    void removeEntry(QHash<QByteArray, Entry>::iterator it)
+    {
+        QFile::remove(QDir(MESH_CACHE_PATH).filePath(it->fileName));
+        m_totalSize -= it->size;
+        m_removed.insert(it.key());
+        m_inserted.remove(it.key());
+        m_entries.erase(it);
+    }
+
+    void evict()
+    {
+        if (m_totalSize <= MESH_CACHE_MAX_SIZE)
+            return;
+
+        QList<QByteArray> keys = m_entries.keys();
+        std::sort(keys.begin(), keys.end(), [this](const QByteArray &a, const QByteArray &b) {
+            return m_entries.value(a).lastUsed < m_entries.value(b).lastUsed;
+        });
+
+        for (const auto &key : std::as_const(keys)) {
+            if (m_totalSize <= MESH_CACHE_MAX_SIZE)
+                break;
+            auto it = m_entries.find(key);
+            qCDebug(lcQuick3dPhysics) << "Evicted" << it->fileName << "from the cache";
+            removeEntry(it);
+        }
+    }
+
+    // Takes the entries other processes added to the index since it was loaded, and drops the
+    // ones they removed, except for the entries this process inserted or removed itself
+    void merge()
+    {
+        const QHash<QByteArray, Entry> onDisk = readIndex();
+        QHash<QByteArray, Entry> merged;
+        for (auto it = onDisk.cbegin(); it != onDisk.cend(); ++it) {
+            if (!m_removed.contains(it.key()))
+                merged.insert(it.key(), *it);
+        }
+        for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+            auto mergedIt = merged.find(it.key());
+            if (m_inserted.contains(it.key()))
+                merged.insert(it.key(), *it);
+            else if (mergedIt != merged.end())
+                mergedIt->lastUsed = qMax(mergedIt->lastUsed, it->lastUsed);
+        }
+
+        m_entries = merged;
+        m_totalSize = 0;
+        for (const auto &entry : std::as_const(m_entries))
+            m_totalSize += entry.size;
+        evict();
+    }
+
+    void save()
+    {
+        QLockFile lock(indexPath() + QStringLiteral(".lock"));
+        if (!lock.lock()) {
+            qCWarning(lcQuick3dPhysics) << "Could not lock the cache index.";
+            return;
+        }
+        merge();
+
+        QSaveFile file(indexPath());
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            qCWarning(lcQuick3dPhysics) << "Could not open" << file.fileName() << "for writing.";
+            return;
+        }
+
+        file.write(CACHE_INDEX_HEADER);
+        file.write("\n");
+        for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+            file.write(it.key() + ' ' + it->fileName.toUtf8() + ' ' + QByteArray::number(it->size)
+                       + ' ' + QByteArray::number(it->lastUsed) + '\n');
+        }
+        if (file.commit()) {
+            m_dirty = false;
+            m_inserted.clear();
+            m_removed.clear();
+        }
+    }
+
+    QMutex m_mutex;
+    QHash<QByteArray, Entry> m_entries;
+    // Changes since the index was last written, to merge it with the one on disk
+    QSet<QByteArray> m_inserted;
+    QSet<QByteArray> m_removed;
+    qint64 m_totalSize = 0;
+    bool m_loaded = false;
+    bool m_dirty = false;
+};
+
+Q_GLOBAL_STATIC(CacheIndex, s_cacheIndex);
+
+static CacheIndex *cacheIndex()
+{
+    return s_cacheIndex();
+}
+
+// Cache entries are written on a thread of their own so cooking does not wait for the disk
+class CacheWriter : public QThreadPool
+{
+public:
+    CacheWriter()
+    {
+        // Created first so the index outlives the pending writes, which are waited for when the
+        // writer is destroyed
+        cacheIndex();
+        setMaxThreadCount(1);
+    }
+};
+
+Q_GLOBAL_STATIC(CacheWriter, s_cacheWriter);
+
+static void saveCacheIndex()
+{
+    if (s_cacheWriter.exists())
+        s_cacheWriter->waitForDone();
+    if (s_cacheIndex.exists())
+        s_cacheIndex->saveIfDirty();
+}
+
+static const char *cacheExtension(CacheGeometry geom)
 {
-    const char *extension = "unknown_physx";
     switch (geom) {
     case CacheGeometry::TriangleMesh:
-        extension = "triangle_physx";
-        break;
+        return "triangle_physx";
     case CacheGeometry::ConvexMesh:
-        extension = "convex_physx";
-        break;
+        return "convex_physx";
     case CacheGeometry::HeightField:
-        extension = "heightfield_physx";
-        break;
+        return "heightfield_physx";
+    case CacheGeometry::ConvexDecomposition:
+        return "decomposition_physx";
     }
+    return "unknown_physx";
+}
 
-    return QString::fromUtf8("%1/%2.%3")
-            .arg(MESH_CACHE_PATH, QFileInfo(filePath).fileName(), QLatin1StringView(extension));
+template<typename T>
+static void addKeyData(QCryptographicHash &hash, const T &value)
+{
+    hash.addData(QByteArrayView(reinterpret_cast<const char *>(&value), sizeof(T)));
 }
 
-static void readCachedMesh(const QString &meshFilename, physx::PxPhysics &physics,
-                           physx::PxTriangleMesh *&triangleMesh, physx::PxConvexMesh *&convexMesh,
-                           physx::PxHeightField *&heightField, CacheGeometry geom)
+// The key covers everything that affects the cooked data: the source, the kind of geometry, the
+// cooking parameters and the PhysX version. Without explicit parameters the ones of the shared
+// cooking object are used.
+static QByteArray cacheKey(QByteArrayView source, CacheGeometry geom,
+                           const physx::PxCookingParams *cookingParams = nullptr)
 {
-    if (MESH_CACHE_PATH.isEmpty())
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(source);
+    addKeyData(hash, geom);
+    addKeyData(hash, quint32(PX_PHYSICS_VERSION));
+
+    if (!cookingParams) {
+        if (const auto *cooking = QPhysicsWorld::getCooking())
+            cookingParams = &cooking->getParams();
+    }
+    if (cookingParams) {
+        const physx::PxCookingParams &params = *cookingParams;
+        addKeyData(hash, params.areaTestEpsilon);
+        addKeyData(hash, params.planeTolerance);
+        addKeyData(hash, params.convexMeshCookingType);
+        addKeyData(hash, params.suppressTriangleMeshRemapTable);
+        addKeyData(hash, params.buildTriangleAdjacencies);
+        addKeyData(hash, params.buildGPUData);
+        addKeyData(hash, params.scale.length);
+        addKeyData(hash, params.scale.speed);
+        addKeyData(hash, quint32(params.meshPreprocessParams));
+        addKeyData(hash, params.meshWeldTolerance);
+        addKeyData(hash, params.gaussMapLimit);
+        const physx::PxMeshMidPhase::Enum midphase = params.midphaseDesc.getType();
+        addKeyData(hash, midphase);
+        if (midphase == physx::PxMeshMidPhase::eBVH33) {
+            addKeyData(hash, params.midphaseDesc.mBVH33Desc.meshCookingHint);
+            addKeyData(hash, params.midphaseDesc.mBVH33Desc.meshSizePerformanceTradeOff);
+        } else {
+            addKeyData(hash, params.midphaseDesc.mBVH34Desc.numPrimsPerLeaf);
+        }
+    }
+
+    return hash.result().toHex();
+}
+
+static QByteArray fileCacheKey(const QString &filePath, CacheGeometry geom,
+                               const QByteArray &variant = QByteArray(),
+                               const physx::PxCookingParams *params = nullptr)
+{
+    QByteArray source = QFileInfo(filePath).absoluteFilePath().toUtf8();
+    if (!variant.isEmpty())
+        source.append('\0').append(variant);
+    return cacheKey(source, geom, params);
+}
+
+static QByteArray contentCacheKey(const QByteArray &contentHash, CacheGeometry geom,
+                                  const physx::PxCookingParams *params = nullptr)
+{
+    return cacheKey(QByteArray("content:" + contentHash), geom, params);
+}
+
+static QString getCachedFilename(const QByteArray &key, CacheGeometry geom)
+{
+    return QString::fromLatin1(key) + QLatin1Char('.') + QLatin1StringView(cacheExtension(geom));
+}
+
+// Hashes the file in chunks so large meshes do not have to be mapped or read at once
+static bool hashFile(const QString &filePath, quint64 &hash)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    constexpr qint64 chunkSize = 1024 * 1024;
+    QByteArray chunk(chunkSize, Qt::Uninitialized);
+    size_t seed = 0;
+    qint64 read = 0;
+    while ((read = file.read(chunk.data(), chunkSize)) > 0)
+        seed = qHash(QByteArrayView(chunk.constData(), read), seed);
+
+    hash = seed;
+    return read == 0;
+}
+
+// Passes the cooked data of a valid entry to read. Entries without a source file are addressed
+// by the content they were cooked from and are always valid.
+template<typename Read>
+static void readCachedData(const QByteArray &key, const QString &meshFilename, CacheGeometry geom,
+                           Read read)
+{
+    if (!cacheIndex()->contains(key))
         return;
 
-    QString cacheFilename = getCachedFilename(meshFilename, geom);
-    QFile cacheFile(cacheFilename);
-    QFile meshFile(meshFilename);
+    QFile cacheFile(QDir(MESH_CACHE_PATH).filePath(getCachedFilename(key, geom)));
     uchar *cacheData = nullptr;
-    uchar *meshData = nullptr;
+    bool valid = false;
 
     auto cleanup = qScopeGuard([&] {
         if (cacheData)
             cacheFile.unmap(cacheData);
-        if (meshData)
-            meshFile.unmap(meshData);
         if (cacheFile.isOpen())
             cacheFile.close();
-        if (meshFile.isOpen())
-            meshFile.close();
+        if (!valid)
+            cacheIndex()->remove(key);
     });
 
-    if (!cacheFile.open(QIODevice::ReadOnly)) {
-        return;
-    }
-    if (!meshFile.open(QIODevice::ReadOnly)) {
-        qWarning() << "Could not open" << meshFilename;
+    if (!cacheFile.open(QIODevice::ReadOnly))
         return;
-    }
 
-    // first uint64 (8 bytes) is hash of input file
-    if (cacheFile.size() <= qint64(sizeof(uint64_t))) {
-        qWarning() << "Invalid convex mesh from file" << cacheFilename;
+    if (cacheFile.size() <= qint64(sizeof(CacheHeader))) {
+        qWarning() << "Invalid cached mesh in file" << cacheFile.fileName();
         return;
     }
 
     cacheData = cacheFile.map(0, cacheFile.size());
     if (!cacheData) {
-        qWarning() << "Could not map" << cacheFilename;
+        qWarning() << "Could not map" << cacheFile.fileName();
         return;
     }
-    uint64_t cacheHash = *reinterpret_cast<uint64_t *>(cacheData);
 
-    meshData = meshFile.map(0, meshFile.size());
-    if (!meshData) {
-        qWarning() << "Could not map" << meshFilename;
+    CacheHeader header;
+    memcpy(&header, cacheData, sizeof(CacheHeader));
+    if (header.magic != CACHE_MAGIC || header.version != CACHE_VERSION)
         return;
+
+    // Size and modification time are enough when they match, the contents are only hashed when
+    // the file was touched
+    const QFileInfo meshInfo(meshFilename);
+    if (!meshFilename.isEmpty() && meshInfo.size() != header.sourceSize)
+        return; // size is different, need to re-cook
+
+    const qint64 modified = meshInfo.lastModified().toMSecsSinceEpoch();
+    if (!meshFilename.isEmpty() && modified != header.sourceModified) {
+        quint64 meshHash = 0;
+        if (!hashFile(meshFilename, meshHash) || meshHash != header.sourceHash)
+            return; // hash is different, need to re-cook
+
+        // Same contents, store the new time so the next lookup is cheap again
+        header.sourceModified = modified;
+        QFile headerFile(cacheFile.fileName());
+        if (headerFile.open(QIODevice::ReadWrite))
+            headerFile.write(reinterpret_cast<const char *>(&header), sizeof(CacheHeader));
     }
-    uint64_t meshHash = qHash(QByteArrayView(meshData, meshFile.size()));
 
-    if (cacheHash != meshHash)
-        return; // hash is different, need to re-cook
+    valid = true;
+    cacheIndex()->touch(key);
 
-    physx::PxDefaultMemoryInputData input(cacheData + sizeof(uint64_t),
-                                          physx::PxU32(cacheFile.size() - sizeof(uint64_t)));
+    read(cacheData + sizeof(CacheHeader), physx::PxU32(cacheFile.size() - sizeof(CacheHeader)),
+         cacheFile.fileName());
+}
 
-    switch (geom) {
-    case CacheGeometry::TriangleMesh: {
-        triangleMesh = physics.createTriangleMesh(input);
-        qCDebug(lcQuick3dPhysics) << "Read triangle mesh" << triangleMesh << "from file"
-                                  << cacheFilename;
-        break;
-    }
-    case CacheGeometry::ConvexMesh: {
-        convexMesh = physics.createConvexMesh(input);
-        qCDebug(lcQuick3dPhysics) << "Read convex mesh" << convexMesh << "from file"
-                                  << cacheFilename;
-        break;
+static void readCachedMesh(const QByteArray &key, const QString &meshFilename,
+                           physx::PxPhysics &physics, physx::PxTriangleMesh *&triangleMesh,
+                           physx::PxConvexMesh *&convexMesh, physx::PxHeightField *&heightField,
+                           CacheGeometry geom)
+{
+    const auto read = [&](uchar *data, physx::PxU32 size, const QString &fileName) {
+        physx::PxDefaultMemoryInputData input(data, size);
+
+        switch (geom) {
+        case CacheGeometry::TriangleMesh: {
+            triangleMesh = physics.createTriangleMesh(input);
+            qCDebug(lcQuick3dPhysics) << "Read triangle mesh" << triangleMesh << "from file"
+                                      << fileName;
+            break;
+        }
+        case CacheGeometry::ConvexMesh: {
+            convexMesh = physics.createConvexMesh(input);
+            qCDebug(lcQuick3dPhysics) << "Read convex mesh" << convexMesh << "from file"
+                                      << fileName;
+            break;
+        }
+        case CacheGeometry::HeightField:
+            heightField = physics.createHeightField(input);
+            qCDebug(lcQuick3dPhysics) << "Read height field" << heightField << "from file"
+                                      << fileName;
+            break;
+        case CacheGeometry::ConvexDecomposition:
+            Q_UNREACHABLE();
+            break;
+        }
+    };
+    readCachedData(key, meshFilename, geom, read);
+}
+
+// A convex decomposition is the size and the cooked data of every hull, one after the other
+static QList<physx::PxConvexMesh *> readConvexDecomposition(uchar *data, physx::PxU32 size,
+                                                            physx::PxPhysics &physics)
+{
+    QList<physx::PxConvexMesh *> parts;
+    physx::PxU32 offset = 0;
+    while (offset < size) {
+        quint32 partSize = 0;
+        if (size - offset < sizeof(quint32))
+            break;
+        memcpy(&partSize, data + offset, sizeof(quint32));
+        offset += sizeof(quint32);
+        if (partSize > size - offset)
+            break;
+
+        physx::PxDefaultMemoryInputData input(data + offset, partSize);
+        auto *part = physics.createConvexMesh(input);
+        if (!part)
+            break;
+        parts.append(part);
+        offset += partSize;
     }
-    case CacheGeometry::HeightField:
-        heightField = physics.createHeightField(input);
-        qCDebug(lcQuick3dPhysics) << "Read height field" << heightField << "from file"
-                                  << cacheFilename;
-        break;
+
+    if (offset != size) {
+        for (auto *part : std::as_const(parts))
+            part->release();
+        return {};
     }
+    return parts;
 }
 
-static void writeCachedMesh(const QString &meshFilename, physx::PxDefaultMemoryOutputStream &buf,
-                            CacheGeometry geom)
+static void writeConvexDecomposition(physx::PxDefaultMemoryOutputStream &buf,
+                                     const QList<QByteArray> &parts)
 {
-    if (MESH_CACHE_PATH.isEmpty())
-        return;
-
-    QString cacheFilename = getCachedFilename(meshFilename, geom);
-    QFile cacheFile(cacheFilename);
-    QFile meshFile(meshFilename);
-    uchar *cacheData = nullptr;
-    uchar *meshData = nullptr;
+    for (const QByteArray &part : parts) {
+        const quint32 partSize = quint32(part.size());
+        buf.write(&partSize, sizeof(quint32));
+        buf.write(part.constData(), partSize);
+    }
+}
 
-    auto cleanup = qScopeGuard([&] {
-        if (cacheData)
-            cacheFile.unmap(cacheData);
-        if (meshData)
-            meshFile.unmap(meshData);
-        if (cacheFile.isOpen())
-            cacheFile.close();
-        if (meshFile.isOpen())
-            meshFile.close();
-    });
+static void writeCacheFile(const QByteArray &key, const QString &meshFilename,
+                           const QByteArray &data, CacheGeometry geom)
+{
+    const QString fileName = getCachedFilename(key, geom);
+
+    CacheHeader header = {};
+    header.magic = CACHE_MAGIC;
+    header.version = CACHE_VERSION;
+    if (!meshFilename.isEmpty()) {
+        const QFileInfo meshInfo(meshFilename);
+        header.sourceSize = meshInfo.size();
+        header.sourceModified = meshInfo.lastModified().toMSecsSinceEpoch();
+        if (!hashFile(meshFilename, header.sourceHash)) {
+            qWarning() << "Could not open" << meshFilename;
+            return;
+        }
+    }
 
+    // Written to a temporary file first since meshes can be cooked on several threads
+    QSaveFile cacheFile(QDir(MESH_CACHE_PATH).filePath(fileName));
     if (!cacheFile.open(QIODevice::WriteOnly)) {
         qCWarning(lcQuick3dPhysics) << "Could not open" << cacheFile.fileName() << "for writing.";
         return;
     }
-    if (!meshFile.open(QIODevice::ReadOnly)) {
-        qWarning() << "Could not open" << meshFilename;
-        return;
-    }
 
-    meshData = meshFile.map(0, meshFile.size());
-    if (!meshData) {
-        qWarning() << "Could not map" << meshFilename;
+    cacheFile.write(reinterpret_cast<const char *>(&header), sizeof(CacheHeader));
+    cacheFile.write(data);
+    const qint64 size = cacheFile.size();
+    if (!cacheFile.commit()) {
+        qCWarning(lcQuick3dPhysics) << "Could not write" << cacheFile.fileName();
         return;
     }
-    uint64_t meshHash = qHash(QByteArrayView(meshData, meshFile.size()));
 
-    cacheFile.write(reinterpret_cast<char *>(&meshHash), sizeof(uint64_t));
-    cacheFile.write(reinterpret_cast<char *>(buf.getData()), buf.getSize());
-    cacheFile.close();
+    cacheIndex()->insert(key, fileName, size);
+    qCDebug(lcQuick3dPhysics) << "Wrote" << size << "bytes to" << cacheFile.fileName();
+}
 
-    qCDebug(lcQuick3dPhysics) << "Wrote" << cacheFile.size() << "bytes to" << cacheFile.fileName();
+// The entry is not in the index until it has been written, so it can not be read half written
+static void writeCachedMesh(const QByteArray &key, const QString &meshFilename,
+                            physx::PxDefaultMemoryOutputStream &buf, CacheGeometry geom)
+{
+    const QByteArray data(reinterpret_cast<const char *>(buf.getData()), buf.getSize());
+    s_cacheWriter->start([key, meshFilename, data, geom] {
+        writeCacheFile(key, meshFilename, data, geom);
+    });
+}
+
+bool isEnabled()
+{
+    return !MESH_CACHE_PATH.isEmpty();
 }
 
-void writeCachedTriangleMesh(const QString &filePath, physx::PxDefaultMemoryOutputStream &buf)
+void writeCachedTriangleMesh(const QString &filePath, physx::PxDefaultMemoryOutputStream &buf,
+                             const QByteArray &variant, const physx::PxCookingParams *params)
 {
-    writeCachedMesh(filePath, buf, CacheGeometry::TriangleMesh);
+    if (!MESH_CACHE_PATH.isEmpty())
+        writeCachedMesh(fileCacheKey(filePath, CacheGeometry::TriangleMesh, variant, params),
+                        filePath, buf, CacheGeometry::TriangleMesh);
 }
 
-void writeCachedConvexMesh(const QString &filePath, physx::PxDefaultMemoryOutputStream &buf)
+void writeCachedConvexMesh(const QString &filePath, physx::PxDefaultMemoryOutputStream &buf,
+                           const QByteArray &variant, const physx::PxCookingParams *params)
 {
-    writeCachedMesh(filePath, buf, CacheGeometry::ConvexMesh);
+    if (!MESH_CACHE_PATH.isEmpty())
+        writeCachedMesh(fileCacheKey(filePath, CacheGeometry::ConvexMesh, variant, params),
+                        filePath, buf, CacheGeometry::ConvexMesh);
 }
 
 void writeCachedHeightField(const QString &filePath, physx::PxDefaultMemoryOutputStream &buf)
 {
-    writeCachedMesh(filePath, buf, CacheGeometry::HeightField);
+    if (!MESH_CACHE_PATH.isEmpty())
+        writeCachedMesh(fileCacheKey(filePath, CacheGeometry::HeightField), filePath, buf,
+                        CacheGeometry::HeightField);
+}
+
+void writeCachedTriangleMesh(const QByteArray &contentHash,
+                             physx::PxDefaultMemoryOutputStream &buf,
+                             const physx::PxCookingParams *params)
+{
+    if (!MESH_CACHE_PATH.isEmpty())
+        writeCachedMesh(contentCacheKey(contentHash, CacheGeometry::TriangleMesh, params),
+                        QString(), buf, CacheGeometry::TriangleMesh);
+}
+
+void writeCachedConvexMesh(const QByteArray &contentHash, physx::PxDefaultMemoryOutputStream &buf,
+                           const physx::PxCookingParams *params)
+{
+    if (!MESH_CACHE_PATH.isEmpty())
+        writeCachedMesh(contentCacheKey(contentHash, CacheGeometry::ConvexMesh, params),
+                        QString(), buf, CacheGeometry::ConvexMesh);
+}
+
+physx::PxTriangleMesh *readCachedTriangleMesh(const QByteArray &contentHash,
+                                              physx::PxPhysics &physics)
+{
+    physx::PxTriangleMesh *triangleMesh = nullptr;
+    physx::PxConvexMesh *convexMesh = nullptr;
+    physx::PxHeightField *heightField = nullptr;
+    if (!MESH_CACHE_PATH.isEmpty())
+        readCachedMesh(contentCacheKey(contentHash, CacheGeometry::TriangleMesh), QString(),
+                       physics, triangleMesh, convexMesh, heightField,
+                       CacheGeometry::TriangleMesh);
+    return triangleMesh;
+}
+
+physx::PxConvexMesh *readCachedConvexMesh(const QByteArray &contentHash, physx::PxPhysics &physics)
+{
+    physx::PxTriangleMesh *triangleMesh = nullptr;
+    physx::PxConvexMesh *convexMesh = nullptr;
+    physx::PxHeightField *heightField = nullptr;
+    if (!MESH_CACHE_PATH.isEmpty())
+        readCachedMesh(contentCacheKey(contentHash, CacheGeometry::ConvexMesh), QString(), physics,
+                       triangleMesh, convexMesh, heightField, CacheGeometry::ConvexMesh);
+    return convexMesh;
+}
+
+void writeCachedConvexDecomposition(const QString &filePath, const QList<QByteArray> &parts,
+                                    const QByteArray &variant,
+                                    const physx::PxCookingParams *params)
+{
+    if (MESH_CACHE_PATH.isEmpty())
+        return;
+    physx::PxDefaultMemoryOutputStream buf;
+    writeConvexDecomposition(buf, parts);
+    writeCachedMesh(fileCacheKey(filePath, CacheGeometry::ConvexDecomposition, variant, params),
+                    filePath, buf, CacheGeometry::ConvexDecomposition);
+}
+
+void writeCachedConvexDecomposition(const QByteArray &contentHash, const QList<QByteArray> &parts,
+                                    const physx::PxCookingParams *params)
+{
+    if (MESH_CACHE_PATH.isEmpty())
+        return;
+    physx::PxDefaultMemoryOutputStream buf;
+    writeConvexDecomposition(buf, parts);
+    writeCachedMesh(contentCacheKey(contentHash, CacheGeometry::ConvexDecomposition, params),
+                    QString(), buf, CacheGeometry::ConvexDecomposition);
+}
+
+QList<physx::PxConvexMesh *> readCachedConvexDecomposition(const QString &filePath,
+                                                           physx::PxPhysics &physics,
+                                                           const QByteArray &variant)
+{
+    QList<physx::PxConvexMesh *> parts;
+    if (!MESH_CACHE_PATH.isEmpty()) {
+        readCachedData(fileCacheKey(filePath, CacheGeometry::ConvexDecomposition, variant),
+                       filePath, CacheGeometry::ConvexDecomposition,
+                       [&](uchar *data, physx::PxU32 size, const QString &) {
+                           parts = readConvexDecomposition(data, size, physics);
+                       });
+    }
+    return parts;
+}
+
+QList<physx::PxConvexMesh *> readCachedConvexDecomposition(const QByteArray &contentHash,
+                                                           physx::PxPhysics &physics)
+{
+    QList<physx::PxConvexMesh *> parts;
+    if (!MESH_CACHE_PATH.isEmpty()) {
+        readCachedData(contentCacheKey(contentHash, CacheGeometry::ConvexDecomposition), QString(),
+                       CacheGeometry::ConvexDecomposition,
+                       [&](uchar *data, physx::PxU32 size, const QString &) {
+                           parts = readConvexDecomposition(data, size, physics);
+                       });
+    }
+    return parts;
+}
+
+// Assets of a collision asset collection are deserialized in place instead of being parsed
+static bool readCollectionAsset(const QString &source, physx::PxPhysics &physics,
+                                physx::PxTriangleMesh *&triangleMesh,
+                                physx::PxConvexMesh *&convexMesh,
+                                physx::PxHeightField *&heightField, CacheGeometry geom)
+{
+    QCollisionAssets::Kind kind = QCollisionAssets::Kind::TriangleMesh;
+    switch (geom) {
+    case CacheGeometry::TriangleMesh:
+        kind = QCollisionAssets::Kind::TriangleMesh;
+        break;
+    case CacheGeometry::ConvexMesh:
+        kind = QCollisionAssets::Kind::ConvexMesh;
+        break;
+    case CacheGeometry::HeightField:
+        kind = QCollisionAssets::Kind::HeightField;
+        break;
+    case CacheGeometry::ConvexDecomposition:
+        Q_UNREACHABLE();
+        break;
+    }
+
+    physx::PxBase *asset = nullptr;
+    if (!QCollisionAssets::find(source, kind, physics, asset))
+        return false;
+
+    if (asset) {
+        triangleMesh = asset->is<physx::PxTriangleMesh>();
+        convexMesh = asset->is<physx::PxConvexMesh>();
+        heightField = asset->is<physx::PxHeightField>();
+        qCDebug(lcQuick3dPhysics) << "Found" << asset->getConcreteTypeName() << "in" << source;
+    } else {
+        qWarning() << "Collision asset collection" << source << "has no asset of this type";
+    }
+    return true;
 }
 
 static void readCookedMesh(const QString &meshFilename, physx::PxPhysics &physics,
                            physx::PxTriangleMesh *&triangleMesh, physx::PxConvexMesh *&convexMesh,
                            physx::PxHeightField *&heightField, CacheGeometry geom)
 {
+    if (readCollectionAsset(meshFilename, physics, triangleMesh, convexMesh, heightField, geom))
+        return;
+
     QFile file(meshFilename);
     uchar *data = nullptr;
 
@@ -214,26 +761,34 @@ static void readCookedMesh(const QString &meshFilename, physx::PxPhysics &physic
     case CacheGeometry::HeightField:
         heightField = physics.createHeightField(input);
         break;
+    case CacheGeometry::ConvexDecomposition:
+        Q_UNREACHABLE();
+        break;
     }
 }
 
-physx::PxTriangleMesh *readCachedTriangleMesh(const QString &filePath, physx::PxPhysics &physics)
+physx::PxTriangleMesh *readCachedTriangleMesh(const QString &filePath, physx::PxPhysics &physics,
+                                              const QByteArray &variant)
 {
     physx::PxTriangleMesh *triangleMesh = nullptr;
     physx::PxConvexMesh *convexMesh = nullptr;
     physx::PxHeightField *heightField = nullptr;
-    readCachedMesh(filePath, physics, triangleMesh, convexMesh, heightField,
-                   CacheGeometry::TriangleMesh);
+    if (!MESH_CACHE_PATH.isEmpty())
+        readCachedMesh(fileCacheKey(filePath, CacheGeometry::TriangleMesh, variant), filePath,
+                       physics, triangleMesh, convexMesh, heightField,
+                       CacheGeometry::TriangleMesh);
     return triangleMesh;
 }
 
-physx::PxConvexMesh *readCachedConvexMesh(const QString &filePath, physx::PxPhysics &physics)
+physx::PxConvexMesh *readCachedConvexMesh(const QString &filePath, physx::PxPhysics &physics,
+                                          const QByteArray &variant)
 {
     physx::PxTriangleMesh *triangleMesh = nullptr;
     physx::PxConvexMesh *convexMesh = nullptr;
     physx::PxHeightField *heightField = nullptr;
-    readCachedMesh(filePath, physics, triangleMesh, convexMesh, heightField,
-                   CacheGeometry::ConvexMesh);
+    if (!MESH_CACHE_PATH.isEmpty())
+        readCachedMesh(fileCacheKey(filePath, CacheGeometry::ConvexMesh, variant), filePath,
+                       physics, triangleMesh, convexMesh, heightField, CacheGeometry::ConvexMesh);
     return convexMesh;
 }
 
@@ -242,8 +797,9 @@ physx::PxHeightField *readCachedHeightField(const QString &filePath, physx::PxPh
     physx::PxTriangleMesh *triangleMesh = nullptr;
     physx::PxConvexMesh *convexMesh = nullptr;
     physx::PxHeightField *heightField = nullptr;
-    readCachedMesh(filePath, physics, triangleMesh, convexMesh, heightField,
-                   CacheGeometry::HeightField);
+    if (!MESH_CACHE_PATH.isEmpty())
+        readCachedMesh(fileCacheKey(filePath, CacheGeometry::HeightField), filePath, physics,
+                       triangleMesh, convexMesh, heightField, CacheGeometry::HeightField);
     return heightField;
 }
 
@@ -16,6 +16,8 @@
 //
 
 #include <QtCore/qtconfigmacros.h>
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
 #include <QtCore/QString>
 
 namespace physx {
@@ -24,21 +26,56 @@ class PxTriangleMesh;
 class PxConvexMesh;
 class PxPhysics;
 class PxHeightField;
+struct PxCookingParams;
 }
 
 QT_BEGIN_NAMESPACE
 namespace QCacheUtils {
-void writeCachedTriangleMesh(const QString &filePath, physx::PxDefaultMemoryOutputStream &buf);
-void writeCachedConvexMesh(const QString &filePath, physx::PxDefaultMemoryOutputStream &buf);
+// Whether a cache directory is set. Cooked data is only needed when it is, otherwise meshes can
+// be cooked directly into PhysX objects.
+bool isEnabled();
+
+// The entries are written asynchronously. The variant tells apart meshes cooked from the same
+// file with different options. The entries are keyed by the given cooking parameters, or by the
+// parameters of the shared cooking object if there are none.
+void writeCachedTriangleMesh(const QString &filePath, physx::PxDefaultMemoryOutputStream &buf,
+                             const QByteArray &variant = QByteArray(),
+                             const physx::PxCookingParams *params = nullptr);
+void writeCachedConvexMesh(const QString &filePath, physx::PxDefaultMemoryOutputStream &buf,
+                           const QByteArray &variant = QByteArray(),
+                           const physx::PxCookingParams *params = nullptr);
 void writeCachedHeightField(const QString &filePath, physx::PxDefaultMemoryOutputStream &buf);
 
 physx::PxTriangleMesh *readCookedTriangleMesh(const QString &filePath, physx::PxPhysics &physics);
 physx::PxConvexMesh *readCookedConvexMesh(const QString &filePath, physx::PxPhysics &physics);
 physx::PxHeightField *readCookedHeightField(const QString &filePath, physx::PxPhysics &physics);
 
-physx::PxTriangleMesh *readCachedTriangleMesh(const QString &filePath, physx::PxPhysics &physics);
-physx::PxConvexMesh *readCachedConvexMesh(const QString &filePath, physx::PxPhysics &physics);
+physx::PxTriangleMesh *readCachedTriangleMesh(const QString &filePath, physx::PxPhysics &physics,
+                                              const QByteArray &variant = QByteArray());
+physx::PxConvexMesh *readCachedConvexMesh(const QString &filePath, physx::PxPhysics &physics,
+                                          const QByteArray &variant = QByteArray());
 physx::PxHeightField *readCachedHeightField(const QString &filePath, physx::PxPhysics &physics);
+
+// Caching of meshes cooked from geometry data, addressed by a hash of the data
+void writeCachedTriangleMesh(const QByteArray &contentHash, physx::PxDefaultMemoryOutputStream &buf,
+                             const physx::PxCookingParams *params = nullptr);
+void writeCachedConvexMesh(const QByteArray &contentHash, physx::PxDefaultMemoryOutputStream &buf,
+                           const physx::PxCookingParams *params = nullptr);
+physx::PxTriangleMesh *readCachedTriangleMesh(const QByteArray &contentHash,
+                                              physx::PxPhysics &physics);
+physx::PxConvexMesh *readCachedConvexMesh(const QByteArray &contentHash, physx::PxPhysics &physics);
+
+// Convex decompositions are stored as one entry holding the cooked convex mesh of every hull
+void writeCachedConvexDecomposition(const QString &filePath, const QList<QByteArray> &parts,
+                                    const QByteArray &variant = QByteArray(),
+                                    const physx::PxCookingParams *params = nullptr);
+void writeCachedConvexDecomposition(const QByteArray &contentHash, const QList<QByteArray> &parts,
+                                    const physx::PxCookingParams *params = nullptr);
+QList<physx::PxConvexMesh *>
+readCachedConvexDecomposition(const QString &filePath, physx::PxPhysics &physics,
+                              const QByteArray &variant = QByteArray());
+QList<physx::PxConvexMesh *> readCachedConvexDecomposition(const QByteArray &contentHash,
+                                                           physx::PxPhysics &physics);
 }
 QT_END_NAMESPACE
 
@@ -43,18 +43,15 @@ QT_BEGIN_NAMESPACE
 
 QCapsuleShape::QCapsuleShape() = default;
 
-QCapsuleShape::~QCapsuleShape()
-{
-    delete m_physXGeometry;
-}
+QCapsuleShape::~QCapsuleShape() = default;
 
 physx::PxGeometry *QCapsuleShape::getPhysXGeometry()
 {
-    if (!m_physXGeometry || m_scaleDirty) {
+    if (!physXGeometry() || m_scaleDirty) {
         updatePhysXGeometry();
     }
 
-    return m_physXGeometry;
+    return physXGeometry();
 }
 
 float QCapsuleShape::diameter() const
@@ -91,11 +88,10 @@ void QCapsuleShape::setHeight(float newHeight)
 
 void QCapsuleShape::updatePhysXGeometry()
 {
-    delete m_physXGeometry;
     QVector3D s = sceneScale();
     qreal rs = s.y();
     qreal hs = s.x();
-    m_physXGeometry = new physx::PxCapsuleGeometry(rs * m_diameter * 0.5f, hs * m_height * 0.5f);
+    setPhysXGeometry(physx::PxCapsuleGeometry(rs * m_diameter * 0.5f, hs * m_height * 0.5f));
     m_scaleDirty = false;
 }
 
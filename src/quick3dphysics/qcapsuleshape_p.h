@@ -19,10 +19,6 @@
 #include <QtQuick3DPhysics/private/qabstractcollisionshape_p.h>
 #include <QtQml/QQmlEngine>
 
-namespace physx {
-class PxCapsuleGeometry;
-}
-
 QT_BEGIN_NAMESPACE
 
 class Q_QUICK3DPHYSICS_EXPORT QCapsuleShape : public QAbstractCollisionShape
@@ -50,7 +46,6 @@ Q_SIGNALS:
 
 private:
     void updatePhysXGeometry();
-    physx::PxCapsuleGeometry *m_physXGeometry = nullptr;
     float m_diameter = 100.0f;
     float m_height = 100.0f;
 };
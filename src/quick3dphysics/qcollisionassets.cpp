@@ -0,0 +1,160 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "qcollisionassets_p.h"
+
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <extensions/PxExtensionsAPI.h>
+
+#include "qphysicsworld_p.h"
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+namespace QCollisionAssets {
+
+static_assert(DataAlignment == PX_SERIAL_FILE_ALIGN);
+
+namespace {
+struct Collection
+{
+    // The deserialized objects live in either the mapped file or the copy
+    QFile *file = nullptr;
+    void *copy = nullptr;
+    physx::PxCollection *collection = nullptr;
+};
+}
+
+// The memory of a collection is only released after the physics instance, which releases the
+// objects in it. Collections still loaded at exit are left to the operating system, since the
+// physics instance may outlive this.
+class Collections
+{
+public:
+    bool find(const QString &filePath, quint64 id, physx::PxPhysics &physics,
+              physx::PxBase *&object)
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_collections.find(filePath);
+        if (it == m_collections.end()) {
+            Collection collection = load(filePath, physics);
+            // Failures are not remembered, the file may be written or cooked again before the
+            // next try
+            if (!collection.collection)
+                return false;
+            it = m_collections.insert(filePath, collection);
+        }
+        object = it->collection->find(id);
+        return true;
+    }
+
+    void clear()
+    {
+        QMutexLocker locker(&m_mutex);
+        for (const Collection &collection : std::as_const(m_collections)) {
+            if (collection.collection)
+                collection.collection->release();
+            delete collection.file;
+            qFreeAligned(collection.copy);
+        }
+        m_collections.clear();
+        if (m_registry) {
+            m_registry->release();
+            m_registry = nullptr;
+        }
+    }
+
+private:
+    Collection load(const QString &filePath, physx::PxPhysics &physics);
+
+    QMutex m_mutex;
+    physx::PxSerializationRegistry *m_registry = nullptr;
+    QHash<QString, Collection> m_collections;
+};
+
+Collection Collections::load(const QString &filePath, physx::PxPhysics &physics)
+{
+    Collection result;
+    auto file = std::make_unique<QFile>(filePath);
+    if (!file->open(QIODevice::ReadOnly))
+        return result;
+
+    // Anything else, like a mesh file with an index, is not a collection
+    Header header;
+    if (file->read(reinterpret_cast<char *>(&header), sizeof(Header)) != qint64(sizeof(Header))
+        || header.magic != Magic)
+        return result;
+
+    if (header.version != Version || header.physxVersion != PX_PHYSICS_VERSION) {
+        qWarning() << "Collision asset collection" << filePath
+                   << "was cooked for another version and needs to be cooked again";
+        return result;
+    }
+    if (header.dataOffset < sizeof(Header) || header.dataOffset % DataAlignment != 0
+        || header.dataSize == 0 || header.dataOffset + header.dataSize > quint64(file->size())) {
+        qWarning() << "Invalid collision asset collection" << filePath;
+        return result;
+    }
+
+    // Deserializing fixes up the pointers in the data. The private mapping keeps the changes out
+    // of the file and only copies the pages that are written to.
+    void *data = file->map(header.dataOffset, header.dataSize, QFileDevice::MapPrivateOption);
+    if (!data || quintptr(data) % DataAlignment != 0) {
+        // Not every file can be mapped, resources for instance, so it is read into an aligned
+        // copy instead
+        if (data)
+            file->unmap(static_cast<uchar *>(data));
+        result.copy = qMallocAligned(header.dataSize, DataAlignment);
+        if (!result.copy || !file->seek(header.dataOffset)
+            || file->read(static_cast<char *>(result.copy), header.dataSize)
+                    != qint64(header.dataSize)) {
+            qWarning() << "Could not read collision asset collection" << filePath;
+            qFreeAligned(result.copy);
+            return {};
+        }
+        data = result.copy;
+    }
+
+    if (!m_registry)
+        m_registry = physx::PxSerialization::createSerializationRegistry(physics);
+    result.collection = physx::PxSerialization::createCollectionFromBinary(data, *m_registry);
+    if (!result.collection) {
+        qWarning() << "Could not read collision asset collection" << filePath;
+        qFreeAligned(result.copy);
+        return {};
+    }
+
+    qCDebug(lcQuick3dPhysics) << "Read" << result.collection->getNbObjects()
+                              << "objects from collision asset collection" << filePath;
+    if (!result.copy)
+        result.file = file.release();
+    return result;
+}
+
+Q_GLOBAL_STATIC(Collections, s_collections);
+
+bool find(const QString &source, Kind kind, physx::PxPhysics &physics, physx::PxBase *&object)
+{
+    object = nullptr;
+    const qsizetype separator = source.lastIndexOf(QLatin1Char('#'));
+    if (separator <= 0)
+        return false;
+
+    bool ok = false;
+    const quint32 asset = QStringView(source).sliced(separator + 1).toUInt(&ok);
+    if (!ok || asset == 0)
+        return false;
+
+    return s_collections->find(source.left(separator), objectId(asset, kind), physics, object);
+}
+
+void releaseCollections()
+{
+    if (s_collections.exists())
+        s_collections->clear();
+}
+
+}
+QT_END_NAMESPACE
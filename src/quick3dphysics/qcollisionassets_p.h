@@ -0,0 +1,70 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef QCOLLISIONASSETS_P_H
+#define QCOLLISIONASSETS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qtconfigmacros.h>
+#include <QtCore/QString>
+
+namespace physx {
+class PxBase;
+class PxPhysics;
+}
+
+QT_BEGIN_NAMESPACE
+
+// A collision asset collection holds the cooked meshes and height fields of many sources in one
+// file, written by the cooker. It is the header below followed by a PhysX binary collection at
+// dataOffset, which is aligned so the collection can be deserialized in place in the mapped file.
+// The assets are numbered from 1 in the order they were cooked and are used as the source
+// "<file>#<asset>".
+namespace QCollisionAssets {
+
+struct Header
+{
+    quint32 magic;
+    quint32 version;
+    quint32 physxVersion;
+    quint32 assetCount;
+    quint64 dataOffset;
+    quint64 dataSize;
+};
+
+constexpr quint32 Magic = 0x41585051; // "QPXA"
+constexpr quint32 Version = 1;
+constexpr quint64 DataAlignment = 128; // PX_SERIAL_FILE_ALIGN
+
+enum class Kind : quint32 { TriangleMesh = 1, ConvexMesh = 2, HeightField = 3 };
+
+// Every asset holds at most one object of every kind
+constexpr quint64 objectId(quint32 asset, Kind kind)
+{
+    return (quint64(asset) << 2) | quint32(kind);
+}
+
+// Returns whether the source, of the form "<file>#<asset>", is in a collection. The object is set
+// to the object of the given kind of the asset, or nullptr if it has none. Collections are loaded
+// once and kept until releaseCollections() is called, files that fail to load are tried again on
+// the next call.
+bool find(const QString &source, Kind kind, physx::PxPhysics &physics, physx::PxBase *&object);
+
+// Releases the memory of the collections, which may only be done after the physics instance that
+// the objects were created with is released
+void releaseCollections();
+}
+
+QT_END_NAMESPACE
+
+#endif // QCOLLISIONASSETS_P_H
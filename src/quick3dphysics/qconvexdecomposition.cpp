@@ -0,0 +1,385 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "qconvexdecomposition_p.h"
+
+#include "qphysicsmeshutils_p_p.h"
+#include "qphysicsworld_p.h"
+
+#include "cooking/PxConvexMeshDesc.h"
+#include "cooking/PxCooking.h"
+#include "extensions/PxDefaultStreams.h"
+#include "geometry/PxConvexMesh.h"
+
+#include <QtCore/QSet>
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cmath>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    The decomposition is a simplified form of the approach taken by V-HACD. The mesh is
+    rasterized into voxels, the inside is filled, and the voxels are split recursively along
+    axis aligned planes. Every step splits the part whose convex hull covers the most volume
+    outside of the mesh, at the plane that minimizes the volume of the two resulting hulls.
+    The splitting stops when the maximum number of hulls is reached or when no part is more
+    concave than the given limit.
+*/
+
+namespace QConvexDecomposition {
+
+enum VoxelState : quint8 { Outside, Surface, Interior, Exterior };
+
+struct VoxelCoordinates
+{
+    int x;
+    int y;
+    int z;
+};
+
+// The mesh rasterized into cubic voxels. The grid has a border of outside voxels so that the
+// voxels outside of the mesh are all connected.
+class VoxelGrid
+{
+public:
+    VoxelGrid(const QList<QVector3D> &vertices, const QList<quint32> &indices, int resolution)
+    {
+        QVector3D minimum = vertices.constFirst();
+        QVector3D maximum = minimum;
+        for (const QVector3D &vertex : vertices) {
+            minimum = QVector3D(qMin(minimum.x(), vertex.x()), qMin(minimum.y(), vertex.y()),
+                                qMin(minimum.z(), vertex.z()));
+            maximum = QVector3D(qMax(maximum.x(), vertex.x()), qMax(maximum.y(), vertex.y()),
+                                qMax(maximum.z(), vertex.z()));
+        }
+
+        const QVector3D extent = maximum - minimum;
+        const float longest = qMax(extent.x(), qMax(extent.y(), extent.z()));
+        if (!(longest > 0))
+            return;
+
+        m_size = longest / resolution;
+        for (int axis = 0; axis < 3; axis++)
+            m_dims[axis] = qMax(1, int(std::ceil(extent[axis] / m_size))) + 2;
+        m_origin = minimum - QVector3D(m_size, m_size, m_size);
+        m_states.fill(Outside, qsizetype(m_dims[0]) * m_dims[1] * m_dims[2]);
+
+        rasterizeSurface(vertices, indices);
+        fillInterior();
+    }
+
+    bool isEmpty() const { return m_states.isEmpty(); }
+    qsizetype voxelCount() const { return m_states.size(); }
+    float voxelVolume() const { return m_size * m_size * m_size; }
+    VoxelState state(int index) const { return m_states[index]; }
+
+    int index(int x, int y, int z) const { return x + m_dims[0] * (y + m_dims[1] * z); }
+
+    int index(const QVector3D &position) const
+    {
+        const QVector3D local = (position - m_origin) / m_size;
+        return index(qBound(1, int(local.x()), m_dims[0] - 2),
+                     qBound(1, int(local.y()), m_dims[1] - 2),
+                     qBound(1, int(local.z()), m_dims[2] - 2));
+    }
+
+    VoxelCoordinates coordinates(int index) const
+    {
+        return { index % m_dims[0], (index / m_dims[0]) % m_dims[1],
+                 index / (m_dims[0] * m_dims[1]) };
+    }
+
+    // The position of the lowest corner of the voxel
+    QVector3D corner(int x, int y, int z) const
+    {
+        return m_origin + QVector3D(float(x), float(y), float(z)) * m_size;
+    }
+
+    QVector3D center(int x, int y, int z) const
+    {
+        return corner(x, y, z) + QVector3D(m_size, m_size, m_size) * 0.5f;
+    }
+
+    // The indices of the six neighbors, only valid for voxels that are not on the border
+    std::array<int, 6> neighbors(int index) const
+    {
+        const int layer = m_dims[0] * m_dims[1];
+        return { index - 1, index + 1, index - m_dims[0], index + m_dims[0], index - layer,
+                 index + layer };
+    }
+
+private:
+    // Marks the voxels touched by the triangles by sampling them at half the voxel size
+    void rasterizeSurface(const QList<QVector3D> &vertices, const QList<quint32> &indices)
+    {
+        const qsizetype triangleCount = (indices.isEmpty() ? vertices.size() : indices.size()) / 3;
+        for (qsizetype i = 0; i < triangleCount; i++) {
+            quint32 corners[3];
+            for (int j = 0; j < 3; j++)
+                corners[j] = indices.isEmpty() ? quint32(i * 3 + j) : indices[i * 3 + j];
+            if (corners[0] >= quint32(vertices.size()) || corners[1] >= quint32(vertices.size())
+                || corners[2] >= quint32(vertices.size()))
+                continue;
+
+            const QVector3D &a = vertices[corners[0]];
+            const QVector3D ab = vertices[corners[1]] - a;
+            const QVector3D ac = vertices[corners[2]] - a;
+            const float edge = qMax(ab.length(), qMax(ac.length(), (ac - ab).length()));
+            const int steps = qMax(1, int(std::ceil(2 * edge / m_size)));
+            for (int u = 0; u <= steps; u++) {
+                for (int v = 0; u + v <= steps; v++) {
+                    const QVector3D sample = a + ab * (float(u) / steps) + ac * (float(v) / steps);
+                    m_states[index(sample)] = Surface;
+                }
+            }
+        }
+    }
+
+    // Everything that can not be reached from the border without crossing the surface is
+    // inside of the mesh. Meshes that are not closed have no inside.
+    void fillInterior()
+    {
+        QList<int> stack { 0 };
+        m_states[0] = Exterior;
+        while (!stack.isEmpty()) {
+            const int current = stack.takeLast();
+            const auto [x, y, z] = coordinates(current);
+            const int adjacent[6][3] = { { x - 1, y, z }, { x + 1, y, z }, { x, y - 1, z },
+                                         { x, y + 1, z }, { x, y, z - 1 }, { x, y, z + 1 } };
+            for (const auto &n : adjacent) {
+                if (n[0] < 0 || n[1] < 0 || n[2] < 0 || n[0] >= m_dims[0] || n[1] >= m_dims[1]
+                    || n[2] >= m_dims[2])
+                    continue;
+                const int neighbor = index(n[0], n[1], n[2]);
+                if (m_states[neighbor] == Outside) {
+                    m_states[neighbor] = Exterior;
+                    stack.append(neighbor);
+                }
+            }
+        }
+
+        for (auto &state : m_states)
+            state = state == Exterior ? Outside : state == Outside ? Interior : state;
+    }
+
+    QVector3D m_origin;
+    float m_size = 0;
+    int m_dims[3] = {};
+    QList<VoxelState> m_states;
+};
+
+struct Part
+{
+    QList<int> voxels;
+    float hullVolume = 0;
+    float concavity = 0;
+};
+
+// The points spanning the convex hull of the voxels for which inPart() is true. Voxels inside
+// of the part do not contribute. Surface voxels contribute their center and the mesh vertices
+// inside of them, voxels inside of the mesh contribute their corners so that the hulls of
+// neighboring parts touch.
+template<typename InPart>
+static QList<QVector3D> hullPoints(const VoxelGrid &grid, const QList<int> &voxels,
+                                   const QList<QVector3D> &vertices, InPart inPart)
+{
+    QList<QVector3D> points;
+    QSet<int> corners;
+    for (const int voxel : voxels) {
+        if (!inPart(voxel))
+            continue;
+
+        bool isBoundary = false;
+        for (const int neighbor : grid.neighbors(voxel))
+            isBoundary |= !inPart(neighbor);
+        if (!isBoundary)
+            continue;
+
+        const auto [x, y, z] = grid.coordinates(voxel);
+        if (grid.state(voxel) == Surface) {
+            points.append(grid.center(x, y, z));
+            continue;
+        }
+        for (int i = 0; i < 8; i++) {
+            const int cx = x + (i & 1), cy = y + ((i >> 1) & 1), cz = z + ((i >> 2) & 1);
+            const int corner = grid.index(cx, cy, cz);
+            if (!corners.contains(corner)) {
+                corners.insert(corner);
+                points.append(grid.corner(cx, cy, cz));
+            }
+        }
+    }
+
+    for (const QVector3D &vertex : vertices) {
+        if (inPart(grid.index(vertex)))
+            points.append(vertex);
+    }
+    return points;
+}
+
+static void describeHull(physx::PxConvexMeshDesc &desc, const QList<QVector3D> &points)
+{
+    desc.points.count = physx::PxU32(points.size());
+    desc.points.stride = sizeof(QVector3D);
+    desc.points.data = points.constData();
+}
+
+// The volume of the convex hull of the points, the hull is created through the insertion
+// callback and released right away
+static float hullVolume(const QList<QVector3D> &points, physx::PxCooking &cooking,
+                        physx::PxPhysicsInsertionCallback &insertionCallback)
+{
+    if (points.size() < 4)
+        return 0;
+
+    physx::PxConvexMeshDesc desc;
+    describeHull(desc, points);
+    desc.flags = physx::PxConvexFlag::eCOMPUTE_CONVEX;
+    physx::PxConvexMesh *mesh = cooking.createConvexMesh(desc, insertionCallback);
+    if (!mesh)
+        return 0;
+
+    physx::PxReal mass = 0;
+    physx::PxMat33 inertia;
+    physx::PxVec3 centerOfMass;
+    mesh->getMassInformation(mass, inertia, centerOfMass);
+    mesh->release();
+    return mass;
+}
+
+QList<QByteArray> cook(const QList<QVector3D> &vertices, const QList<quint32> &indices,
+                       const QQuick3DPhysicsHullOptions &options, physx::PxCooking &cooking,
+                       physx::PxPhysicsInsertionCallback &insertionCallback)
+{
+    if (vertices.isEmpty())
+        return {};
+
+    const VoxelGrid grid(vertices, indices, options.resolution);
+    if (grid.isEmpty())
+        return {};
+
+    // The part each voxel belongs to, or -1 for voxels outside of the mesh
+    QList<int> labels(grid.voxelCount(), -1);
+    QList<Part> parts(1);
+    for (int i = 0; i < grid.voxelCount(); i++) {
+        if (grid.state(i) != Outside) {
+            labels[i] = 0;
+            parts[0].voxels.append(i);
+        }
+    }
+
+    const auto volumeOf = [&](const Part &part, auto inPart) {
+        return hullVolume(hullPoints(grid, part.voxels, vertices, inPart), cooking,
+                          insertionCallback);
+    };
+
+    parts[0].hullVolume = volumeOf(parts[0], [&](int i) { return labels[i] == 0; });
+    const float totalVolume = parts[0].hullVolume;
+    const auto updateConcavity = [&](Part &part) {
+        const float volume = part.voxels.size() * grid.voxelVolume();
+        part.concavity = totalVolume > 0 ? qMax(0.f, part.hullVolume - volume) / totalVolume : 0;
+    };
+    updateConcavity(parts[0]);
+
+    while (parts.size() < options.maximumHulls) {
+        auto worst = std::max_element(parts.begin(), parts.end(), [](const Part &a, const Part &b) {
+            return a.concavity < b.concavity;
+        });
+        if (worst->concavity <= options.maximumConcavity)
+            break;
+
+        const int label = int(worst - parts.begin());
+        int lower[3] = { INT_MAX, INT_MAX, INT_MAX };
+        int upper[3] = { INT_MIN, INT_MIN, INT_MIN };
+        for (const int voxel : std::as_const(worst->voxels)) {
+            const auto [x, y, z] = grid.coordinates(voxel);
+            const int c[3] = { x, y, z };
+            for (int axis = 0; axis < 3; axis++) {
+                lower[axis] = qMin(lower[axis], c[axis]);
+                upper[axis] = qMax(upper[axis], c[axis]);
+            }
+        }
+
+        // Tries a few evenly spaced planes along every axis, voxels below the plane go to the
+        // first part
+        constexpr int planesPerAxis = 5;
+        int bestAxis = -1;
+        int bestPlane = 0;
+        float bestCost = 0;
+        float bestVolumes[2] = {};
+        for (int axis = 0; axis < 3; axis++) {
+            const int span = upper[axis] - lower[axis];
+            const int planes = qMin(span, planesPerAxis);
+            for (int p = 1; p <= planes; p++) {
+                const int plane = lower[axis] + (span + 1) * p / (planes + 1);
+                const auto below = [&](int i) {
+                    const auto [x, y, z] = grid.coordinates(i);
+                    const int c[3] = { x, y, z };
+                    return labels[i] == label && c[axis] < plane;
+                };
+                const auto above = [&](int i) { return labels[i] == label && !below(i); };
+                const float volumes[2] = { volumeOf(*worst, below), volumeOf(*worst, above) };
+                if (bestAxis < 0 || volumes[0] + volumes[1] < bestCost) {
+                    bestAxis = axis;
+                    bestPlane = plane;
+                    bestCost = volumes[0] + volumes[1];
+                    bestVolumes[0] = volumes[0];
+                    bestVolumes[1] = volumes[1];
+                }
+            }
+        }
+
+        // A part that is a single voxel can not be split any further
+        if (bestAxis < 0) {
+            worst->concavity = 0;
+            continue;
+        }
+
+        Part split;
+        QList<int> kept;
+        for (const int voxel : std::as_const(worst->voxels)) {
+            const auto [x, y, z] = grid.coordinates(voxel);
+            const int c[3] = { x, y, z };
+            if (c[bestAxis] < bestPlane) {
+                kept.append(voxel);
+            } else {
+                split.voxels.append(voxel);
+                labels[voxel] = int(parts.size());
+            }
+        }
+        worst->voxels = std::move(kept);
+        worst->hullVolume = bestVolumes[0];
+        updateConcavity(*worst);
+        split.hullVolume = bestVolumes[1];
+        updateConcavity(split);
+        parts.append(std::move(split));
+    }
+
+    QList<QByteArray> cooked;
+    for (qsizetype label = 0; label < parts.size(); label++) {
+        const QList<QVector3D> points = hullPoints(grid, parts[label].voxels, vertices,
+                                                   [&](int i) { return labels[i] == label; });
+        if (points.size() < 4)
+            continue;
+
+        physx::PxConvexMeshDesc desc;
+        describeHull(desc, points);
+        options.apply(desc);
+
+        physx::PxDefaultMemoryOutputStream buf;
+        if (!cooking.cookConvexMesh(desc, buf))
+            continue;
+        cooked.append(QByteArray(reinterpret_cast<const char *>(buf.getData()), buf.getSize()));
+    }
+
+    qCDebug(lcQuick3dPhysics) << "Decomposed mesh with" << vertices.size() << "vertices into"
+                              << cooked.size() << "convex hulls";
+    return cooked;
+}
+
+} // namespace QConvexDecomposition
+
+QT_END_NAMESPACE
@@ -0,0 +1,44 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef QCONVEXDECOMPOSITION_P_H
+#define QCONVEXDECOMPOSITION_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qtconfigmacros.h>
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtGui/QVector3D>
+
+namespace physx {
+class PxCooking;
+class PxPhysicsInsertionCallback;
+}
+
+QT_BEGIN_NAMESPACE
+
+struct QQuick3DPhysicsHullOptions;
+
+namespace QConvexDecomposition {
+// Splits the triangle mesh into convex parts and returns the cooked convex mesh of every part,
+// or an empty list if the mesh could not be decomposed. Meshes without indices are read as a
+// list of triangles. The insertion callback is used for the temporary hulls that estimate the
+// concavity of the parts, which makes this safe to call from a worker thread.
+QList<QByteArray> cook(const QList<QVector3D> &vertices, const QList<quint32> &indices,
+                       const QQuick3DPhysicsHullOptions &options, physx::PxCooking &cooking,
+                       physx::PxPhysicsInsertionCallback &insertionCallback);
+}
+
+QT_END_NAMESPACE
+
+#endif // QCONVEXDECOMPOSITION_P_H
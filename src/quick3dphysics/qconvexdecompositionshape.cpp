@@ -0,0 +1,142 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "qconvexdecompositionshape_p.h"
+#include "qphysicsmeshutils_p_p.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \qmltype ConvexDecompositionShape
+    \inherits ConvexMeshShape
+    \inqmlmodule QtQuick3D.Physics
+    \since 6.10
+    \brief A collision shape made of several convex hulls approximating a concave mesh.
+
+    This type splits a concave mesh into a set of convex parts and uses the convex hull of every
+    part as a collision shape. Unlike a TriangleMeshShape, a ConvexDecompositionShape can be used
+    with a DynamicRigidBody that is not kinematic, and unlike a ConvexMeshShape it keeps the
+    cavities of the mesh, so for example a ball can roll inside of a bowl.
+
+    The mesh is rasterized into voxels and the voxels are split recursively along axis aligned
+    planes until there are \l maximumHulls parts, or until no part is more concave than
+    \l maximumConcavity. The mesh should be closed, since the inside of a mesh with holes can
+    not be told apart from the outside.
+
+    Decomposing a mesh is considerably more expensive than computing a single convex hull. Set
+    \l{ConvexMeshShape::}{asynchronous} to decompose it on a worker thread, and set the
+    \c QT_PHYSICS_CACHE_PATH environment variable to store the result on disk, see the
+    \l{Qt Quick 3D Physics Cooking}{cooking overview documentation}.
+
+    The properties of ConvexMeshShape that control the convex hull, such as
+    \l{ConvexMeshShape::}{vertexLimit}, apply to each of the hulls.
+
+    \sa {Qt Quick 3D Physics Shapes and Bodies}{Shapes and Bodies overview documentation}
+*/
+
+/*!
+    \qmlproperty int ConvexDecompositionShape::maximumHulls
+    \since 6.10
+
+    This property defines the maximum number of convex hulls the mesh is split into. Every hull
+    is a separate PhysX shape, so fewer hulls are cheaper to simulate.
+
+    Default value: \c 8
+
+    Range: \c{[1, 64]}
+*/
+
+/*!
+    \qmlproperty real ConvexDecompositionShape::maximumConcavity
+    \since 6.10
+
+    This property defines how concave a part may be before it is split further. The concavity
+    of a part is the volume its convex hull covers outside of the mesh, relative to the volume
+    of the convex hull of the whole mesh.
+
+    Default value: \c 0.05
+
+    Range: \c{[0, 1]}
+*/
+
+/*!
+    \qmlproperty int ConvexDecompositionShape::resolution
+    \since 6.10
+
+    This property defines the number of voxels along the longest side of the mesh used to split
+    it. Higher resolutions preserve smaller details but take longer to decompose.
+
+    Default value: \c 32
+
+    Range: \c{[8, 128]}
+*/
+
+QMeshShape::MeshType QConvexDecompositionShape::shapeType() const
+{
+    return QMeshShape::MeshType::DECOMPOSITION;
+}
+
+int QConvexDecompositionShape::maximumHulls() const
+{
+    return m_maximumHulls;
+}
+
+void QConvexDecompositionShape::setMaximumHulls(int newMaximumHulls)
+{
+    if (newMaximumHulls < 1 || newMaximumHulls > 64) {
+        qWarning() << "Warning: 'maximumHulls' value outside of [1, 64], ignored";
+        return;
+    }
+    if (m_maximumHulls == newMaximumHulls)
+        return;
+    m_maximumHulls = newMaximumHulls;
+    reloadMesh();
+    emit maximumHullsChanged();
+}
+
+float QConvexDecompositionShape::maximumConcavity() const
+{
+    return m_maximumConcavity;
+}
+
+void QConvexDecompositionShape::setMaximumConcavity(float newMaximumConcavity)
+{
+    if (newMaximumConcavity < 0 || newMaximumConcavity > 1) {
+        qWarning() << "Warning: 'maximumConcavity' value outside of [0, 1], ignored";
+        return;
+    }
+    if (qFuzzyCompare(m_maximumConcavity, newMaximumConcavity))
+        return;
+    m_maximumConcavity = newMaximumConcavity;
+    reloadMesh();
+    emit maximumConcavityChanged();
+}
+
+int QConvexDecompositionShape::resolution() const
+{
+    return m_resolution;
+}
+
+void QConvexDecompositionShape::setResolution(int newResolution)
+{
+    if (newResolution < 8 || newResolution > 128) {
+        qWarning() << "Warning: 'resolution' value outside of [8, 128], ignored";
+        return;
+    }
+    if (m_resolution == newResolution)
+        return;
+    m_resolution = newResolution;
+    reloadMesh();
+    emit resolutionChanged();
+}
+
+QQuick3DPhysicsHullOptions QConvexDecompositionShape::hullOptions() const
+{
+    QQuick3DPhysicsHullOptions options = QConvexMeshShape::hullOptions();
+    options.maximumHulls = m_maximumHulls;
+    options.maximumConcavity = m_maximumConcavity;
+    options.resolution = m_resolution;
+    return options;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,58 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef QCONVEXDECOMPOSITIONSHAPE_P_H
+#define QCONVEXDECOMPOSITIONSHAPE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qconvexmeshshape_p.h"
+
+QT_BEGIN_NAMESPACE
+
+class Q_QUICK3DPHYSICS_EXPORT QConvexDecompositionShape : public QConvexMeshShape
+{
+    Q_OBJECT
+    Q_PROPERTY(int maximumHulls READ maximumHulls WRITE setMaximumHulls NOTIFY
+                       maximumHullsChanged FINAL REVISION(6, 10))
+    Q_PROPERTY(float maximumConcavity READ maximumConcavity WRITE setMaximumConcavity NOTIFY
+                       maximumConcavityChanged FINAL REVISION(6, 10))
+    Q_PROPERTY(int resolution READ resolution WRITE setResolution NOTIFY resolutionChanged FINAL
+                       REVISION(6, 10))
+    QML_NAMED_ELEMENT(ConvexDecompositionShape)
+public:
+    QMeshShape::MeshType shapeType() const override;
+
+    Q_REVISION(6, 10) int maximumHulls() const;
+    Q_REVISION(6, 10) void setMaximumHulls(int newMaximumHulls);
+    Q_REVISION(6, 10) float maximumConcavity() const;
+    Q_REVISION(6, 10) void setMaximumConcavity(float newMaximumConcavity);
+    Q_REVISION(6, 10) int resolution() const;
+    Q_REVISION(6, 10) void setResolution(int newResolution);
+
+signals:
+    Q_REVISION(6, 10) void maximumHullsChanged();
+    Q_REVISION(6, 10) void maximumConcavityChanged();
+    Q_REVISION(6, 10) void resolutionChanged();
+
+protected:
+    QQuick3DPhysicsHullOptions hullOptions() const override;
+
+private:
+    int m_maximumHulls = 8;
+    float m_maximumConcavity = 0.05f;
+    int m_resolution = 32;
+};
+
+QT_END_NAMESPACE
+
+#endif // QCONVEXDECOMPOSITIONSHAPE_P_H
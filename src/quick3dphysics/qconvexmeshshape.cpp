@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
 #include "qconvexmeshshape_p.h"
+#include "qphysicsmeshutils_p_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -46,6 +47,78 @@ QT_BEGIN_NAMESPACE
     \since 6.7
 */
 
+/*!
+    \qmlproperty bool ConvexMeshShape::asynchronous
+    \since 6.10
+
+    This property holds whether the convex hull is cooked on a worker thread instead of on the
+    GUI thread. While the hull is being cooked, the \l{ConvexMeshShape::}{status} is
+    \c MeshShape.Loading and the body the shape belongs to is not simulated.
+
+    Default value: \c false
+    \sa TriangleMeshShape::asynchronous
+*/
+
+/*!
+    \qmlproperty enumeration ConvexMeshShape::status
+    \readonly
+    \since 6.10
+
+    This property holds the status of the convex hull. It takes the same values as
+    \l{TriangleMeshShape::}{status}.
+*/
+
+/*!
+    \qmlproperty int ConvexMeshShape::vertexLimit
+    \since 6.10
+
+    This property defines the maximum number of vertices of the convex hull. Hulls with fewer
+    vertices are cheaper to collide, so a detailed mesh used for a small dynamic body can often
+    be reduced to 16 or 32 vertices without a visible difference.
+
+    The lowest limit is \c 8, or \c 4 when \l planeShifting is enabled.
+
+    Default value: \c 255
+
+    Range: \c{[4, 255]}
+*/
+
+/*!
+    \qmlproperty int ConvexMeshShape::quantizedVertexCount
+    \since 6.10
+
+    When this property is larger than \c 0, the vertices of the mesh are reduced to this number
+    of vertices with k-means clustering before the convex hull is computed. This speeds up the
+    cooking of meshes with many vertices and produces smoother hulls.
+
+    Default value: \c 0, meaning the vertices are used as they are.
+
+    Range: \c{[0, 65535]}
+*/
+
+/*!
+    \qmlproperty bool ConvexMeshShape::shiftVertices
+    \since 6.10
+
+    This property defines whether the vertices are moved to be centered around the origin
+    before the convex hull is computed, which improves the numerical precision for meshes that
+    are far from their origin.
+
+    Default value: \c false
+*/
+
+/*!
+    \qmlproperty bool ConvexMeshShape::planeShifting
+    \since 6.10
+
+    This property defines whether the convex hull is reduced to \l vertexLimit vertices by
+    shifting the planes of its faces instead of by dropping vertices. Plane shifting works
+    with limits down to \c 4 vertices, but may produce sharp corners far outside the mesh and
+    does not guarantee that all of the mesh is inside the hull.
+
+    Default value: \c false
+*/
+
 QMeshShape::MeshType QConvexMeshShape::shapeType() const
 {
     return QMeshShape::MeshType::CONVEX;
@@ -56,4 +129,75 @@ bool QConvexMeshShape::isStaticShape() const
     return false;
 }
 
+int QConvexMeshShape::vertexLimit() const
+{
+    return m_vertexLimit;
+}
+
+void QConvexMeshShape::setVertexLimit(int newVertexLimit)
+{
+    if (newVertexLimit < 4 || newVertexLimit > 255) {
+        qWarning() << "Warning: 'vertexLimit' value outside of [4, 255], ignored";
+        return;
+    }
+    if (m_vertexLimit == newVertexLimit)
+        return;
+    m_vertexLimit = newVertexLimit;
+    reloadMesh();
+    emit vertexLimitChanged();
+}
+
+int QConvexMeshShape::quantizedVertexCount() const
+{
+    return m_quantizedVertexCount;
+}
+
+void QConvexMeshShape::setQuantizedVertexCount(int newQuantizedVertexCount)
+{
+    newQuantizedVertexCount = qBound(0, newQuantizedVertexCount, 65535);
+    if (m_quantizedVertexCount == newQuantizedVertexCount)
+        return;
+    m_quantizedVertexCount = newQuantizedVertexCount;
+    reloadMesh();
+    emit quantizedVertexCountChanged();
+}
+
+bool QConvexMeshShape::shiftVertices() const
+{
+    return m_shiftVertices;
+}
+
+void QConvexMeshShape::setShiftVertices(bool newShiftVertices)
+{
+    if (m_shiftVertices == newShiftVertices)
+        return;
+    m_shiftVertices = newShiftVertices;
+    reloadMesh();
+    emit shiftVerticesChanged();
+}
+
+bool QConvexMeshShape::planeShifting() const
+{
+    return m_planeShifting;
+}
+
+void QConvexMeshShape::setPlaneShifting(bool newPlaneShifting)
+{
+    if (m_planeShifting == newPlaneShifting)
+        return;
+    m_planeShifting = newPlaneShifting;
+    reloadMesh();
+    emit planeShiftingChanged();
+}
+
+QQuick3DPhysicsHullOptions QConvexMeshShape::hullOptions() const
+{
+    QQuick3DPhysicsHullOptions options;
+    options.vertexLimit = m_vertexLimit;
+    options.quantizedCount = m_quantizedVertexCount;
+    options.shiftVertices = m_shiftVertices;
+    options.planeShifting = m_planeShifting;
+    return options;
+}
+
 QT_END_NAMESPACE
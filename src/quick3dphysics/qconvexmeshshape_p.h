@@ -22,9 +22,42 @@ QT_BEGIN_NAMESPACE
 class Q_QUICK3DPHYSICS_EXPORT QConvexMeshShape : public QMeshShape
 {
     Q_OBJECT
+    Q_PROPERTY(int vertexLimit READ vertexLimit WRITE setVertexLimit NOTIFY vertexLimitChanged
+                       FINAL REVISION(6, 10))
+    Q_PROPERTY(int quantizedVertexCount READ quantizedVertexCount WRITE setQuantizedVertexCount
+                       NOTIFY quantizedVertexCountChanged FINAL REVISION(6, 10))
+    Q_PROPERTY(bool shiftVertices READ shiftVertices WRITE setShiftVertices NOTIFY
+                       shiftVerticesChanged FINAL REVISION(6, 10))
+    Q_PROPERTY(bool planeShifting READ planeShifting WRITE setPlaneShifting NOTIFY
+                       planeShiftingChanged FINAL REVISION(6, 10))
     QML_NAMED_ELEMENT(ConvexMeshShape)
+public:
     virtual QMeshShape::MeshType shapeType() const override;
     virtual bool isStaticShape() const override;
+
+    Q_REVISION(6, 10) int vertexLimit() const;
+    Q_REVISION(6, 10) void setVertexLimit(int newVertexLimit);
+    Q_REVISION(6, 10) int quantizedVertexCount() const;
+    Q_REVISION(6, 10) void setQuantizedVertexCount(int newQuantizedVertexCount);
+    Q_REVISION(6, 10) bool shiftVertices() const;
+    Q_REVISION(6, 10) void setShiftVertices(bool newShiftVertices);
+    Q_REVISION(6, 10) bool planeShifting() const;
+    Q_REVISION(6, 10) void setPlaneShifting(bool newPlaneShifting);
+
+signals:
+    Q_REVISION(6, 10) void vertexLimitChanged();
+    Q_REVISION(6, 10) void quantizedVertexCountChanged();
+    Q_REVISION(6, 10) void shiftVerticesChanged();
+    Q_REVISION(6, 10) void planeShiftingChanged();
+
+protected:
+    QQuick3DPhysicsHullOptions hullOptions() const override;
+
+private:
+    int m_vertexLimit = 255;
+    int m_quantizedVertexCount = 0;
+    bool m_shiftVertices = false;
+    bool m_planeShifting = false;
 };
 
 QT_END_NAMESPACE
@@ -371,6 +371,14 @@ QQuick3DGeometry *QDebugDrawHelper::generateConvexMeshGeometry(physx::PxConvexMe
 {
     if (!convexMesh)
         return nullptr;
+    return generateConvexMeshGeometry(QList<physx::PxConvexMesh *> { convexMesh });
+}
+
+QQuick3DGeometry *
+QDebugDrawHelper::generateConvexMeshGeometry(const QList<physx::PxConvexMesh *> &convexMeshes)
+{
+    if (convexMeshes.isEmpty())
+        return nullptr;
 
     auto geometry = new QQuick3DGeometry();
     geometry->clear();
@@ -382,38 +390,41 @@ QQuick3DGeometry *QDebugDrawHelper::generateConvexMeshGeometry(physx::PxConvexMe
     geometry->setPrimitiveType(QQuick3DGeometry::PrimitiveType::Lines);
 
     QCollisionDebugMeshBuilder builder;
-
-    const physx::PxU32 nbPolys = convexMesh->getNbPolygons();
-    const physx::PxU8 *polygons = convexMesh->getIndexBuffer();
-    const physx::PxVec3 *verts = convexMesh->getVertices();
-    const physx::PxU32 nbVerts = convexMesh->getNbVertices();
-
-    physx::PxHullPolygon data;
-    for (physx::PxU32 i = 0; i < nbPolys; i++) {
-        convexMesh->getPolygonData(i, data);
-
-        Q_ASSERT(data.mNbVerts > 2);
-        const physx::PxU32 nbTris = physx::PxU32(data.mNbVerts - 2);
-        const physx::PxU8 vref0 = polygons[data.mIndexBase + 0];
-        Q_ASSERT(vref0 < nbVerts);
-
-        for (physx::PxU32 j = 0; j < nbTris; j++) {
-            const physx::PxU32 vref1 = polygons[data.mIndexBase + 0 + j + 1];
-            const physx::PxU32 vref2 = polygons[data.mIndexBase + 0 + j + 2];
-            Q_ASSERT(vref1 < nbVerts);
-            Q_ASSERT(vref2 < nbVerts);
-
-            const QVector3D p0 = QPhysicsUtils::toQtType(verts[vref0]);
-            const QVector3D p1 = QPhysicsUtils::toQtType(verts[vref1]);
-            const QVector3D p2 = QPhysicsUtils::toQtType(verts[vref2]);
-
-            builder.addLine(p0, p1);
-            builder.addLine(p1, p2);
-            builder.addLine(p2, p0);
+    physx::PxBounds3 bounds = physx::PxBounds3::empty();
+
+    for (physx::PxConvexMesh *convexMesh : convexMeshes) {
+        const physx::PxU32 nbPolys = convexMesh->getNbPolygons();
+        const physx::PxU8 *polygons = convexMesh->getIndexBuffer();
+        const physx::PxVec3 *verts = convexMesh->getVertices();
+        const physx::PxU32 nbVerts = convexMesh->getNbVertices();
+
+        physx::PxHullPolygon data;
+        for (physx::PxU32 i = 0; i < nbPolys; i++) {
+            convexMesh->getPolygonData(i, data);
+
+            Q_ASSERT(data.mNbVerts > 2);
+            const physx::PxU32 nbTris = physx::PxU32(data.mNbVerts - 2);
+            const physx::PxU8 vref0 = polygons[data.mIndexBase + 0];
+            Q_ASSERT(vref0 < nbVerts);
+
+            for (physx::PxU32 j = 0; j < nbTris; j++) {
+                const physx::PxU32 vref1 = polygons[data.mIndexBase + 0 + j + 1];
+                const physx::PxU32 vref2 = polygons[data.mIndexBase + 0 + j + 2];
+                Q_ASSERT(vref1 < nbVerts);
+                Q_ASSERT(vref2 < nbVerts);
+
+                const QVector3D p0 = QPhysicsUtils::toQtType(verts[vref0]);
+                const QVector3D p1 = QPhysicsUtils::toQtType(verts[vref1]);
+                const QVector3D p2 = QPhysicsUtils::toQtType(verts[vref2]);
+
+                builder.addLine(p0, p1);
+                builder.addLine(p1, p2);
+                builder.addLine(p2, p0);
+            }
         }
-    }
 
-    auto bounds = convexMesh->getLocalBounds();
+        bounds.include(convexMesh->getLocalBounds());
+    }
 
     geometry->setBounds(QPhysicsUtils::toQtType(bounds.minimum),
                         QPhysicsUtils::toQtType(bounds.maximum));
@@ -16,6 +16,7 @@
 //
 
 #include "qtconfigmacros.h"
+#include <QtCore/qcontainerfwd.h>
 
 namespace physx {
 class PxHeightField;
@@ -35,6 +36,8 @@ QQuick3DGeometry *generatePlaneGeometry();
 QQuick3DGeometry *generateHeightFieldGeometry(physx::PxHeightField *heightField, float heightScale,
                                               float rowScale, float columnScale);
 QQuick3DGeometry *generateConvexMeshGeometry(physx::PxConvexMesh *convexMesh);
+// Draws the hulls of a convex decomposition as one geometry
+QQuick3DGeometry *generateConvexMeshGeometry(const QList<physx::PxConvexMesh *> &convexMeshes);
 QQuick3DGeometry *generateTriangleMeshGeometry(physx::PxTriangleMesh *triangleMesh);
 
 };
@@ -253,8 +253,21 @@ QT_BEGIN_NAMESPACE
     \since 6.9
 
     Is set to \c{true} if the body is sleeping. While it is technically possible to set this property
-    it should be seen as a read-only property that is set on every frame the physics simulation is
-    running.
+    it should be seen as a read-only property that is updated whenever the physics simulation puts
+    the body to sleep or wakes it up.
+*/
+
+/*!
+    \qmlproperty bool DynamicRigidBody::enablePoseIntegrationPreview
+    \since 6.10
+
+    This property enables early reporting of the pose of the body. When set to \c true the
+    position and rotation of the body are updated as soon as the simulation has integrated the new
+    pose, before the rest of the simulation step, including contact and trigger reports, has
+    finished. This reduces the latency for bindings that depend on the pose of the body, for
+    instance a kinematic body following a dynamic body.
+
+    Default value: \c{false}
 */
 
 /*!
@@ -683,6 +696,20 @@ void QDynamicRigidBody::setIsSleeping(bool newIsSleeping)
     emit isSleepingChanged(newIsSleeping);
 }
 
+bool QDynamicRigidBody::enablePoseIntegrationPreview() const
+{
+    return m_enablePoseIntegrationPreview;
+}
+
+void QDynamicRigidBody::setEnablePoseIntegrationPreview(bool enablePoseIntegrationPreview)
+{
+    if (m_enablePoseIntegrationPreview == enablePoseIntegrationPreview)
+        return;
+
+    m_enablePoseIntegrationPreview = enablePoseIntegrationPreview;
+    emit enablePoseIntegrationPreviewChanged();
+}
+
 QAbstractPhysXNode *QDynamicRigidBody::createPhysXBackend()
 {
     return new QPhysXDynamicBody(this);
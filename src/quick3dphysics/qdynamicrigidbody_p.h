@@ -80,6 +80,9 @@ public:
 
     Q_PROPERTY(bool isSleeping READ isSleeping WRITE setIsSleeping NOTIFY isSleepingChanged
                        REVISION(6, 9));
+    Q_PROPERTY(bool enablePoseIntegrationPreview READ enablePoseIntegrationPreview WRITE
+                       setEnablePoseIntegrationPreview NOTIFY enablePoseIntegrationPreviewChanged
+                               REVISION(6, 10));
 
     // clang-format off
 //    // ??? separate simulation control object? --- some of these have default values in the engine, so we need tristate
@@ -162,6 +165,9 @@ public:
     Q_REVISION(6, 9) void setIsSleeping(bool newIsSleeping);
     Q_REVISION(6, 9) bool isSleeping() const;
 
+    Q_REVISION(6, 10) bool enablePoseIntegrationPreview() const;
+    Q_REVISION(6, 10) void setEnablePoseIntegrationPreview(bool enablePoseIntegrationPreview);
+
     QAbstractPhysXNode *createPhysXBackend() final;
 
 Q_SIGNALS:
@@ -181,6 +187,7 @@ Q_SIGNALS:
     Q_REVISION(6, 5) void kinematicEulerRotationChanged(const QVector3D &kinematicEulerRotation);
     Q_REVISION(6, 5) void kinematicPivotChanged(const QVector3D &kinematicPivot);
     Q_REVISION(6, 9) void isSleepingChanged(bool isSleeping);
+    Q_REVISION(6, 10) void enablePoseIntegrationPreviewChanged();
 
 private:
     float m_mass = 1.f;
@@ -202,6 +209,7 @@ private:
     RotationData m_kinematicRotation;
     QVector3D m_kinematicPivot;
     bool m_isSleeping = false;
+    bool m_enablePoseIntegrationPreview = false;
 };
 
 QT_END_NAMESPACE
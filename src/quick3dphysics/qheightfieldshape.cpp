@@ -81,7 +81,13 @@ QQuick3DPhysicsHeightFieldManager::getHeightField(const QUrl &source, const QObj
     const QQmlContext *context = qmlContext(contextObject);
 
     const auto resolvedUrl = context ? context->resolvedUrl(source) : source;
-    const auto qmlSource = QQmlFile::urlToLocalFileOrQrc(resolvedUrl);
+    auto qmlSource = QQmlFile::urlToLocalFileOrQrc(resolvedUrl);
+
+    // The number of an asset in a collision asset collection
+    bool isNumber = false;
+    source.fragment().toUInt(&isNumber);
+    if (isNumber)
+        qmlSource += QLatin1Char('#') + source.fragment();
 
     auto *heightField = heightFieldHash.value(qmlSource);
     if (!heightField) {
@@ -199,19 +205,27 @@ physx::PxHeightField *QQuick3DPhysicsHeightField::heightField()
     hfDesc.samples.data = samples;
     hfDesc.samples.stride = sizeof(physx::PxHeightFieldSample);
 
-    physx::PxDefaultMemoryOutputStream buf;
-
     const auto cooking = QPhysicsWorld::getCooking();
-    if (numRows && numCols && cooking && cooking->cookHeightField(hfDesc, buf)) {
-        auto size = buf.getSize();
-        auto *data = buf.getData();
-        physx::PxDefaultMemoryInputData input(data, size);
-        m_heightField = thePhysics->createHeightField(input);
+    if (numRows && numCols && cooking) {
+        if (readFromFile && QCacheUtils::isEnabled()) {
+            physx::PxDefaultMemoryOutputStream buf;
+            if (cooking->cookHeightField(hfDesc, buf)) {
+                physx::PxDefaultMemoryInputData input(buf.getData(), buf.getSize());
+                m_heightField = thePhysics->createHeightField(input);
+                if (m_heightField)
+                    QCacheUtils::writeCachedHeightField(m_sourcePath, buf);
+            }
+        } else {
+            // Nothing is written to the cache, so the data does not need to be serialized
+            m_heightField =
+                    cooking->createHeightField(hfDesc, thePhysics->getPhysicsInsertionCallback());
+        }
+    }
+
+    if (m_heightField) {
         qCDebug(lcQuick3dPhysics) << "created height field" << m_heightField << numCols << numRows
                                   << "from"
                                   << (readFromFile ? m_sourcePath : QString::fromUtf8("image"));
-        if (readFromFile)
-            QCacheUtils::writeCachedHeightField(m_sourcePath, buf);
     } else {
         qCWarning(lcQuick3dPhysics) << "Could not create height field from"
                                     << (readFromFile ? m_sourcePath : QString::fromUtf8("image"));
@@ -294,23 +308,21 @@ QHeightFieldShape::QHeightFieldShape() = default;
 
 QHeightFieldShape::~QHeightFieldShape()
 {
-    delete m_heightFieldGeometry;
     if (m_heightField)
         QQuick3DPhysicsHeightFieldManager::releaseHeightField(m_heightField);
 }
 
 physx::PxGeometry *QHeightFieldShape::getPhysXGeometry()
 {
-    if (m_dirtyPhysx || m_scaleDirty || !m_heightFieldGeometry) {
+    if (m_dirtyPhysx || m_scaleDirty || !physXGeometry()) {
         updatePhysXGeometry();
     }
-    return m_heightFieldGeometry;
+    return physXGeometry();
 }
 
 void QHeightFieldShape::updatePhysXGeometry()
 {
-    delete m_heightFieldGeometry;
-    m_heightFieldGeometry = nullptr;
+    resetPhysXGeometry();
     if (!m_heightField)
         return;
 
@@ -320,12 +332,12 @@ void QHeightFieldShape::updatePhysXGeometry()
     updateExtents();
     if (hf && cols > 1 && rows > 1) {
         QVector3D scaledExtents = m_extents * sceneScale();
-        m_heightFieldGeometry = new physx::PxHeightFieldGeometry(
+        setPhysXGeometry(physx::PxHeightFieldGeometry(
                 hf, physx::PxMeshGeometryFlags(), scaledExtents.y() / 0x10000,
-                scaledExtents.x() / (cols - 1), scaledExtents.z() / (rows - 1));
+                scaledExtents.x() / (cols - 1), scaledExtents.z() / (rows - 1)));
         m_hfOffset = { -scaledExtents.x() / 2, 0, -scaledExtents.z() / 2 };
 
-        qCDebug(lcQuick3dPhysics) << "created height field geom" << m_heightFieldGeometry << "scale"
+        qCDebug(lcQuick3dPhysics) << "created height field geom" << hf << "scale"
                                   << scaledExtents << m_heightField->columns()
                                   << m_heightField->rows();
     }
@@ -77,7 +77,6 @@ private:
 
     QQuick3DPhysicsHeightField *m_heightField = nullptr;
 
-    physx::PxHeightFieldGeometry *m_heightFieldGeometry = nullptr;
     QVector3D m_hfOffset;
     QUrl m_heightMapSource;
     bool m_dirtyPhysx = false;
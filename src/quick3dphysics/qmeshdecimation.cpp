@@ -0,0 +1,380 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "qmeshdecimation_p.h"
+
+#include <QtCore/QHash>
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    The simplification is the quadric error metric edge collapse by Garland and Heckbert. Every
+    vertex accumulates the planes of the triangles around it in a quadric, which gives the sum
+    of the squared distances of a point to those planes. The edge whose collapse into a single
+    point has the lowest error is collapsed first, and the merged vertex keeps the planes of both
+    vertices. Boundary edges get additional planes perpendicular to their triangle so that the
+    outline of open meshes is kept, and collapses that would flip a triangle are skipped.
+*/
+
+namespace QMeshDecimation {
+
+// Weight of the planes that keep boundary edges in place, relative to the triangle planes
+static constexpr double BoundaryWeight = 10.0;
+
+// Triangles whose normal turns further than this, as the cosine of the angle, block a collapse
+static constexpr float MinimumNormalCosine = 0.2f;
+// Triangles whose normal ends up further than this from the normal of the input triangle block
+// a collapse as well, otherwise a series of smaller turns could still fold the surface over
+static constexpr float MinimumInputNormalCosine = 0.5f;
+
+// Symmetric 4x4 matrix, stored as its upper triangle
+struct Quadric
+{
+    std::array<double, 10> m = {};
+
+    static Quadric fromPlane(const QVector3D &normal, float distance, double weight)
+    {
+        const double plane[4] = { normal.x(), normal.y(), normal.z(), distance };
+        Quadric quadric;
+        int k = 0;
+        for (int i = 0; i < 4; i++) {
+            for (int j = i; j < 4; j++)
+                quadric.m[k++] = weight * plane[i] * plane[j];
+        }
+        return quadric;
+    }
+
+    Quadric &operator+=(const Quadric &other)
+    {
+        for (int i = 0; i < 10; i++)
+            m[i] += other.m[i];
+        return *this;
+    }
+
+    double error(const QVector3D &point) const
+    {
+        const double x = point.x();
+        const double y = point.y();
+        const double z = point.z();
+        return m[0] * x * x + 2 * m[1] * x * y + 2 * m[2] * x * z + 2 * m[3] * x + m[4] * y * y
+                + 2 * m[5] * y * z + 2 * m[6] * y + m[7] * z * z + 2 * m[8] * z + m[9];
+    }
+
+    // The point with the lowest error, if there is a single one
+    bool minimum(QVector3D &point) const
+    {
+        const double a = m[0], b = m[1], c = m[2], d = m[4], e = m[5], f = m[7];
+        const double det = a * (d * f - e * e) - b * (b * f - c * e) + c * (b * e - c * d);
+        if (std::abs(det) < 1e-12)
+            return false;
+
+        const double rx = -m[3], ry = -m[6], rz = -m[8];
+        const double x =
+                (rx * (d * f - e * e) - b * (ry * f - rz * e) + c * (ry * e - rz * d)) / det;
+        const double y =
+                (a * (ry * f - rz * e) - rx * (b * f - c * e) + c * (b * rz - c * ry)) / det;
+        const double z =
+                (a * (d * rz - e * ry) - b * (b * rz - c * ry) + rx * (b * e - c * d)) / det;
+        point = QVector3D(float(x), float(y), float(z));
+        return std::isfinite(point.x()) && std::isfinite(point.y()) && std::isfinite(point.z());
+    }
+};
+
+struct PositionKey
+{
+    float x;
+    float y;
+    float z;
+
+    friend bool operator==(const PositionKey &a, const PositionKey &b)
+    {
+        return a.x == b.x && a.y == b.y && a.z == b.z;
+    }
+    friend size_t qHash(const PositionKey &key, size_t seed = 0)
+    {
+        return qHashMulti(seed, key.x, key.y, key.z);
+    }
+};
+
+struct Collapse
+{
+    double cost;
+    quint32 from;
+    quint32 to;
+    quint32 fromStamp;
+    quint32 toStamp;
+    QVector3D position;
+
+    bool operator>(const Collapse &other) const { return cost > other.cost; }
+};
+
+static quint64 edgeKey(quint32 a, quint32 b)
+{
+    return a < b ? (quint64(a) << 32) | b : (quint64(b) << 32) | a;
+}
+
+static QVector3D faceNormal(const QVector3D &p0, const QVector3D &p1, const QVector3D &p2)
+{
+    return QVector3D::crossProduct(p1 - p0, p2 - p0);
+}
+
+class Simplifier
+{
+public:
+    Simplifier(const QList<QVector3D> &vertices, const QList<quint32> &indices)
+    {
+        // Render meshes duplicate vertices along seams of normals and texture coordinates
+        QHash<PositionKey, quint32> welded;
+        QList<quint32> remap(vertices.size());
+        for (qsizetype i = 0; i < vertices.size(); i++) {
+            const QVector3D &vertex = vertices[i];
+            const auto it = welded.constFind({ vertex.x(), vertex.y(), vertex.z() });
+            if (it != welded.cend()) {
+                remap[i] = *it;
+            } else {
+                remap[i] = quint32(m_positions.size());
+                welded.insert({ vertex.x(), vertex.y(), vertex.z() }, remap[i]);
+                m_positions.append(vertex);
+            }
+        }
+
+        for (qsizetype i = 0; i + 2 < indices.size(); i += 3) {
+            if (indices[i] >= remap.size() || indices[i + 1] >= remap.size()
+                || indices[i + 2] >= remap.size())
+                continue;
+            const std::array<quint32, 3> face = { remap[indices[i]], remap[indices[i + 1]],
+                                                  remap[indices[i + 2]] };
+            if (face[0] != face[1] && face[1] != face[2] && face[0] != face[2])
+                m_faces.append(face);
+        }
+
+        m_faceRemoved.fill(false, m_faces.size());
+        m_faceNormals.resize(m_faces.size());
+        m_vertexFaces.resize(m_positions.size());
+        m_quadrics.resize(m_positions.size());
+        m_removed.fill(false, m_positions.size());
+        m_stamps.fill(0, m_positions.size());
+        m_liveFaces = m_faces.size();
+
+        QHash<quint64, int> edgeFaces;
+        QHash<quint64, int> edgeCounts;
+        for (qsizetype f = 0; f < m_faces.size(); f++) {
+            const auto &face = m_faces[f];
+            const QVector3D normal = faceNormal(m_positions[face[0]], m_positions[face[1]],
+                                                m_positions[face[2]])
+                                             .normalized();
+            m_faceNormals[f] = normal;
+            const Quadric quadric = Quadric::fromPlane(
+                    normal, -QVector3D::dotProduct(normal, m_positions[face[0]]), 1.0);
+            for (int corner = 0; corner < 3; corner++) {
+                m_vertexFaces[face[corner]].append(int(f));
+                m_quadrics[face[corner]] += quadric;
+                const quint64 key = edgeKey(face[corner], face[(corner + 1) % 3]);
+                edgeFaces.insert(key, int(f));
+                edgeCounts[key]++;
+            }
+        }
+
+        for (auto it = edgeCounts.cbegin(); it != edgeCounts.cend(); ++it) {
+            const quint32 a = quint32(it.key() >> 32);
+            const quint32 b = quint32(it.key());
+            if (it.value() == 1)
+                addBoundaryPlane(a, b, edgeFaces.value(it.key()));
+        }
+        for (auto it = edgeCounts.cbegin(); it != edgeCounts.cend(); ++it)
+            push(quint32(it.key() >> 32), quint32(it.key()));
+    }
+
+    void run(int targetTriangles, float tolerance)
+    {
+        const double maximumError = double(tolerance) * tolerance;
+        while (!m_queue.empty()) {
+            if (targetTriangles > 0 && m_liveFaces <= targetTriangles)
+                break;
+
+            const Collapse collapse = m_queue.top();
+            m_queue.pop();
+            if (m_removed[collapse.from] || m_removed[collapse.to]
+                || m_stamps[collapse.from] != collapse.fromStamp
+                || m_stamps[collapse.to] != collapse.toStamp)
+                continue;
+            if (tolerance > 0 && collapse.cost > maximumError)
+                break;
+            if (flipsFace(collapse))
+                continue;
+            apply(collapse);
+        }
+    }
+
+    void result(QList<QVector3D> &vertices, QList<quint32> &indices) const
+    {
+        QList<quint32> remap(m_positions.size(), UINT_MAX);
+        vertices.clear();
+        indices.clear();
+        indices.reserve(m_liveFaces * 3);
+        for (qsizetype f = 0; f < m_faces.size(); f++) {
+            if (m_faceRemoved[f])
+                continue;
+            for (quint32 vertex : m_faces[f]) {
+                if (remap[vertex] == UINT_MAX) {
+                    remap[vertex] = quint32(vertices.size());
+                    vertices.append(m_positions[vertex]);
+                }
+                indices.append(remap[vertex]);
+            }
+        }
+    }
+
+private:
+    void addBoundaryPlane(quint32 a, quint32 b, int face)
+    {
+        const auto &corners = m_faces[face];
+        const QVector3D normal = faceNormal(m_positions[corners[0]], m_positions[corners[1]],
+                                            m_positions[corners[2]]);
+        const QVector3D edgeNormal =
+                QVector3D::crossProduct(m_positions[b] - m_positions[a], normal).normalized();
+        if (edgeNormal.isNull())
+            return;
+        const Quadric quadric = Quadric::fromPlane(
+                edgeNormal, -QVector3D::dotProduct(edgeNormal, m_positions[a]), BoundaryWeight);
+        m_quadrics[a] += quadric;
+        m_quadrics[b] += quadric;
+    }
+
+    void push(quint32 from, quint32 to)
+    {
+        Quadric quadric = m_quadrics[from];
+        quadric += m_quadrics[to];
+
+        // The optimal point can be far away for nearly flat regions, so the end points and the
+        // middle of the edge are candidates as well
+        const QVector3D &a = m_positions[from];
+        const QVector3D &b = m_positions[to];
+        QVector3D candidates[4] = { a, b, (a + b) * 0.5f, {} };
+        const int count = quadric.minimum(candidates[3]) ? 4 : 3;
+
+        Collapse collapse { std::numeric_limits<double>::max(), from, to,
+                            m_stamps[from], m_stamps[to], a };
+        for (int i = 0; i < count; i++) {
+            const double cost = qMax(0.0, quadric.error(candidates[i]));
+            if (cost < collapse.cost) {
+                collapse.cost = cost;
+                collapse.position = candidates[i];
+            }
+        }
+        m_queue.push(collapse);
+    }
+
+    bool flipsFace(const Collapse &collapse) const
+    {
+        for (quint32 vertex : { collapse.from, collapse.to }) {
+            for (int f : m_vertexFaces[vertex]) {
+                if (m_faceRemoved[f])
+                    continue;
+                const auto &face = m_faces[f];
+                const bool hasFrom =
+                        std::find(face.cbegin(), face.cend(), collapse.from) != face.cend();
+                const bool hasTo =
+                        std::find(face.cbegin(), face.cend(), collapse.to) != face.cend();
+                if (hasFrom && hasTo)
+                    continue; // collapses with the edge
+
+                QVector3D corners[3];
+                for (int i = 0; i < 3; i++)
+                    corners[i] = m_positions[face[i]];
+                const QVector3D before = faceNormal(corners[0], corners[1], corners[2]);
+                if (before.isNull())
+                    continue;
+                for (int i = 0; i < 3; i++) {
+                    if (face[i] == vertex)
+                        corners[i] = collapse.position;
+                }
+                const QVector3D after = faceNormal(corners[0], corners[1], corners[2]);
+                if (QVector3D::dotProduct(before, after)
+                    <= MinimumNormalCosine * before.length() * after.length())
+                    return true;
+                if (QVector3D::dotProduct(m_faceNormals[f], after)
+                    <= MinimumInputNormalCosine * after.length())
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    void apply(const Collapse &collapse)
+    {
+        const quint32 from = collapse.from;
+        const quint32 to = collapse.to;
+        m_positions[from] = collapse.position;
+        m_quadrics[from] += m_quadrics[to];
+        m_removed[to] = true;
+        m_stamps[from]++;
+
+        for (int f : std::as_const(m_vertexFaces[to])) {
+            if (m_faceRemoved[f])
+                continue;
+            auto &face = m_faces[f];
+            if (std::find(face.cbegin(), face.cend(), from) != face.cend()) {
+                m_faceRemoved[f] = true;
+                m_liveFaces--;
+                continue;
+            }
+            std::replace(face.begin(), face.end(), to, from);
+            m_vertexFaces[from].append(f);
+        }
+        m_vertexFaces[to].clear();
+
+        // The cost of all edges around the merged vertex changed
+        QList<int> liveFaces;
+        QList<quint32> neighbors;
+        for (int f : std::as_const(m_vertexFaces[from])) {
+            if (m_faceRemoved[f] || liveFaces.contains(f))
+                continue;
+            liveFaces.append(f);
+            for (quint32 vertex : m_faces[f]) {
+                if (vertex != from && !neighbors.contains(vertex))
+                    neighbors.append(vertex);
+            }
+        }
+        m_vertexFaces[from] = liveFaces;
+        for (quint32 neighbor : std::as_const(neighbors))
+            push(from, neighbor);
+    }
+
+    QList<QVector3D> m_positions;
+    QList<std::array<quint32, 3>> m_faces;
+    QList<bool> m_faceRemoved;
+    // Normalized normals of the input triangles
+    QList<QVector3D> m_faceNormals;
+    QList<QList<int>> m_vertexFaces;
+    QList<Quadric> m_quadrics;
+    QList<bool> m_removed;
+    QList<quint32> m_stamps;
+    qsizetype m_liveFaces = 0;
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> m_queue;
+};
+
+void simplify(QList<QVector3D> &vertices, QList<quint32> &indices, int targetTriangles,
+              float tolerance)
+{
+    if (targetTriangles <= 0 && tolerance <= 0)
+        return;
+    if (indices.isEmpty() || (targetTriangles > 0 && indices.size() / 3 <= targetTriangles))
+        return;
+
+    Simplifier simplifier(vertices, indices);
+    simplifier.run(targetTriangles, tolerance);
+    simplifier.result(vertices, indices);
+}
+
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,35 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef QMESHDECIMATION_P_H
+#define QMESHDECIMATION_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtQuick3DPhysics/qtquick3dphysicsglobal.h>
+#include <QtCore/QList>
+#include <QtGui/QVector3D>
+
+QT_BEGIN_NAMESPACE
+
+namespace QMeshDecimation {
+// Simplifies the triangle mesh in place by collapsing the edges that change its shape the least,
+// until it has at most targetTriangles triangles, or until the next collapse would move the
+// surface more than tolerance. A value of 0 disables the respective limit. Vertices at the same
+// position are merged first, so seams of the render mesh do not stop the simplification.
+Q_QUICK3DPHYSICS_EXPORT void simplify(QList<QVector3D> &vertices, QList<quint32> &indices,
+                                      int targetTriangles, float tolerance);
+}
+
+QT_END_NAMESPACE
+
+#endif // QMESHDECIMATION_P_H
@@ -2,13 +2,20 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
 
 #include "qcacheutils_p.h"
+#include "qconvexdecomposition_p.h"
+#include "qmeshdecimation_p.h"
 #include "qmeshshape_p.h"
 
+#include <QCryptographicHash>
 #include <QFile>
 #include <QFileInfo>
+#include <QScopeGuard>
+#include <QThreadPool>
 #include <QtQuick3D/QQuick3DGeometry>
 #include <extensions/PxExtensionsAPI.h>
 
+#include "PxPhysics.h"
+#include "PxPhysicsVersion.h"
 #include "foundation/PxVec3.h"
 #include "cooking/PxConvexMeshDesc.h"
 #include "extensions/PxDefaultStreams.h"
@@ -24,6 +31,10 @@
 #include "qmeshshape_p.h"
 #include "qphysicsworld_p.h"
 #include "qphysicsmeshutils_p_p.h"
+#include "qstaticphysxobjects_p.h"
+
+#include <algorithm>
+#include <limits>
 
 QT_BEGIN_NAMESPACE
 
@@ -41,9 +52,174 @@ attributeBySemantic(const QQuick3DGeometry *geometry,
     return QQuick3DGeometry::Attribute();
 };
 
+// Copies the positions and the triangle indices out of the vertex and index buffers
+static void readTriangles(const QByteArray &vertexData, int stride, int posOffset,
+                          const QByteArray &indexData, bool u16Indices,
+                          QList<QVector3D> &vertices, QList<quint32> &indices)
+{
+    vertices.reserve(vertexData.size() / stride);
+    for (qsizetype i = 0; i + posOffset + qsizetype(sizeof(QVector3D)) <= vertexData.size();
+         i += stride) {
+        QVector3D position;
+        memcpy(&position, vertexData.constData() + i + posOffset, sizeof(QVector3D));
+        vertices.append(position);
+    }
+
+    if (u16Indices) {
+        const auto *data = reinterpret_cast<const quint16 *>(indexData.constData());
+        for (qsizetype i = 0; i < indexData.size() / qsizetype(sizeof(quint16)); i++)
+            indices.append(data[i]);
+    } else {
+        indices.resize(indexData.size() / sizeof(quint32));
+        memcpy(indices.data(), indexData.constData(), indices.size() * sizeof(quint32));
+    }
+}
+
+// Replaces the triangles of the description by a decimated copy, which is kept in vertices and
+// indices, if the options ask for decimation
+static void decimateTriangles(physx::PxTriangleMeshDesc &desc,
+                              const QQuick3DPhysicsHullOptions &options,
+                              QList<QVector3D> &vertices, QList<quint32> &indices)
+{
+    if (!options.decimates())
+        return;
+
+    const auto *points = static_cast<const char *>(desc.points.data);
+    vertices.resize(desc.points.count);
+    QVector3D *positions = vertices.data();
+    for (physx::PxU32 i = 0; i < desc.points.count; i++)
+        memcpy(positions + i, points + i * desc.points.stride, sizeof(QVector3D));
+
+    // Meshes without indices are a list of triangles
+    const auto *triangles = static_cast<const char *>(desc.triangles.data);
+    const bool u16Indices = desc.flags.isSet(physx::PxMeshFlag::e16_BIT_INDICES);
+    if (triangles) {
+        indices.reserve(desc.triangles.count * 3);
+        for (physx::PxU32 i = 0; i < desc.triangles.count; i++) {
+            const char *triangle = triangles + i * desc.triangles.stride;
+            for (int corner = 0; corner < 3; corner++) {
+                indices.append(u16Indices
+                                       ? reinterpret_cast<const quint16 *>(triangle)[corner]
+                                       : reinterpret_cast<const quint32 *>(triangle)[corner]);
+            }
+        }
+    } else {
+        for (qsizetype i = 0; i + 2 < vertices.size(); i += 3)
+            indices << quint32(i) << quint32(i + 1) << quint32(i + 2);
+    }
+
+    QMeshDecimation::simplify(vertices, indices, options.decimationTriangleCount,
+                              options.decimationTolerance);
+
+    desc.points.count = physx::PxU32(vertices.size());
+    desc.points.stride = sizeof(QVector3D);
+    desc.points.data = vertices.constData();
+    desc.triangles.count = physx::PxU32(indices.size() / 3);
+    desc.triangles.stride = sizeof(quint32) * 3;
+    desc.triangles.data = indices.constData();
+    desc.flags.clear(physx::PxMeshFlag::e16_BIT_INDICES);
+}
+
+static QList<physx::PxConvexMesh *> createConvexMeshes(const QList<QByteArray> &cooked,
+                                                       physx::PxPhysics &physics)
+{
+    QList<physx::PxConvexMesh *> meshes;
+    for (const QByteArray &data : cooked) {
+        physx::PxDefaultMemoryInputData input(
+                reinterpret_cast<physx::PxU8 *>(const_cast<char *>(data.constData())),
+                physx::PxU32(data.size()));
+        if (auto *mesh = physics.createConvexMesh(input))
+            meshes.append(mesh);
+    }
+    return meshes;
+}
+
+// Without a cache directory the mesh is cooked directly into a PhysX object, which saves
+// serializing the cooked data and parsing it again. Otherwise the cooked data is passed on to
+// writeCache.
+template<typename WriteCache>
+static physx::PxConvexMesh *cookConvexMesh(const physx::PxConvexMeshDesc &desc,
+                                           physx::PxCooking &cooking, physx::PxPhysics &physics,
+                                           WriteCache writeCache)
+{
+    if (!QCacheUtils::isEnabled())
+        return cooking.createConvexMesh(desc, physics.getPhysicsInsertionCallback());
+
+    physx::PxDefaultMemoryOutputStream buf;
+    if (!cooking.cookConvexMesh(desc, buf))
+        return nullptr;
+    physx::PxDefaultMemoryInputData input(buf.getData(), buf.getSize());
+    physx::PxConvexMesh *mesh = physics.createConvexMesh(input);
+    if (mesh)
+        writeCache(buf);
+    return mesh;
+}
+
+template<typename WriteCache>
+static physx::PxTriangleMesh *cookTriangleMesh(const physx::PxTriangleMeshDesc &desc,
+                                               physx::PxCooking &cooking,
+                                               physx::PxPhysics &physics, WriteCache writeCache)
+{
+    if (!QCacheUtils::isEnabled())
+        return cooking.createTriangleMesh(desc, physics.getPhysicsInsertionCallback());
+
+    physx::PxDefaultMemoryOutputStream buf;
+    if (!cooking.cookTriangleMesh(desc, buf))
+        return nullptr;
+    physx::PxDefaultMemoryInputData input(buf.getData(), buf.getSize());
+    physx::PxTriangleMesh *mesh = physics.createTriangleMesh(input);
+    if (mesh)
+        writeCache(buf);
+    return mesh;
+}
+
+// Nine significant digits tell every float apart, the default six would let options that differ
+// only slightly share cache entries
+static QByteArray floatKey(float value)
+{
+    return QByteArray::number(value, 'g', std::numeric_limits<float>::max_digits10);
+}
+
+QByteArray QQuick3DPhysicsHullOptions::key() const
+{
+    const QQuick3DPhysicsHullOptions defaults;
+    QByteArray result;
+    if (vertexLimit != defaults.vertexLimit || quantizedCount != defaults.quantizedCount
+        || shiftVertices != defaults.shiftVertices || planeShifting != defaults.planeShifting) {
+        result = "hull:" + QByteArray::number(vertexLimit) + ':'
+                + QByteArray::number(quantizedCount) + ':' + QByteArray::number(int(shiftVertices))
+                + ':' + QByteArray::number(int(planeShifting));
+    }
+    if (maximumHulls != defaults.maximumHulls || maximumConcavity != defaults.maximumConcavity
+        || resolution != defaults.resolution) {
+        result += "decomposition:" + QByteArray::number(maximumHulls) + ':'
+                + floatKey(maximumConcavity) + ':' + QByteArray::number(resolution);
+    }
+    if (decimates()) {
+        result += "decimation:" + QByteArray::number(decimationTriangleCount) + ':'
+                + floatKey(decimationTolerance);
+    }
+    return result;
+}
+
+void QQuick3DPhysicsHullOptions::apply(physx::PxConvexMeshDesc &desc) const
+{
+    desc.flags = physx::PxConvexFlag::eCOMPUTE_CONVEX;
+    // Plane shifting can go down to 4 vertices, the default algorithm to 8
+    desc.vertexLimit = physx::PxU16(qBound(planeShifting ? 4 : 8, vertexLimit, 255));
+    if (planeShifting)
+        desc.flags |= physx::PxConvexFlag::ePLANE_SHIFTING;
+    if (shiftVertices)
+        desc.flags |= physx::PxConvexFlag::eSHIFT_VERTICES;
+    if (quantizedCount > 0) {
+        desc.flags |= physx::PxConvexFlag::eQUANTIZE_INPUT;
+        desc.quantizedCount = physx::PxU16(qBound(4, quantizedCount, 65535));
+    }
+}
+
 physx::PxConvexMesh *QQuick3DPhysicsMesh::convexMesh()
 {
-    if (m_convexMesh != nullptr)
+    if (m_convexMesh != nullptr || m_cookingFailed[Convex])
         return m_convexMesh;
 
     physx::PxPhysics *thePhysics = QPhysicsWorld::getPhysics();
@@ -59,7 +235,7 @@ physx::PxConvexMesh *QQuick3DPhysicsMesh::convexMesh()
 
 physx::PxTriangleMesh *QQuick3DPhysicsMesh::triangleMesh()
 {
-    if (m_triangleMesh != nullptr)
+    if (m_triangleMesh != nullptr || m_cookingFailed[Triangle])
         return m_triangleMesh;
 
     physx::PxPhysics *thePhysics = QPhysicsWorld::getPhysics();
@@ -73,11 +249,85 @@ physx::PxTriangleMesh *QQuick3DPhysicsMesh::triangleMesh()
     return nullptr;
 }
 
+QList<physx::PxConvexMesh *> QQuick3DPhysicsMesh::convexDecomposition()
+{
+    if (!m_convexParts.isEmpty() || m_cookingFailed[ConvexDecomposition])
+        return m_convexParts;
+
+    physx::PxPhysics *thePhysics = QPhysicsWorld::getPhysics();
+    const auto cooking = QPhysicsWorld::getCooking();
+    if (thePhysics == nullptr || cooking == nullptr)
+        return {};
+
+    QList<QVector3D> vertices;
+    QList<quint32> indices;
+    QByteArray hash;
+    if (m_meshGeometry) {
+        if (m_meshGeometry->primitiveType() != QQuick3DGeometry::PrimitiveType::Triangles) {
+            qWarning() << "QQuick3DPhysicsMesh: Invalid geometry primitive type, must be "
+                          "Triangles. ";
+            return {};
+        }
+        if (m_meshGeometry->vertexData().isEmpty()) {
+            qWarning() << "QQuick3DPhysicsMesh: Invalid geometry, vertexData is empty. ";
+            return {};
+        }
+
+        hash = geometryHash(ConvexDecomposition);
+        if (loadCachedMesh(ConvexDecomposition, hash))
+            return m_convexParts;
+
+        const auto vertexAttribute =
+                attributeBySemantic(m_meshGeometry, QQuick3DGeometry::Attribute::PositionSemantic);
+        const bool u16Indices = !m_meshGeometry->indexData().isEmpty()
+                && attributeBySemantic(m_meshGeometry, QQuick3DGeometry::Attribute::IndexSemantic)
+                                .componentType
+                        == QQuick3DGeometry::Attribute::U16Type;
+        readTriangles(m_meshGeometry->vertexData(), m_meshGeometry->stride(),
+                      vertexAttribute.offset, m_meshGeometry->indexData(), u16Indices, vertices,
+                      indices);
+    } else if (!m_meshPath.isEmpty()) {
+        if (loadCachedMesh(ConvexDecomposition, QByteArray()))
+            return m_convexParts;
+
+        loadSsgMesh();
+        if (!m_ssgMesh.isValid())
+            return {};
+        readTriangles(m_ssgMesh.vertexBuffer().data, m_ssgMesh.vertexBuffer().stride, m_posOffset,
+                      m_ssgMesh.indexBuffer().data,
+                      m_ssgMesh.indexBuffer().componentType
+                              == QSSGMesh::Mesh::ComponentType::UnsignedInt16,
+                      vertices, indices);
+    } else {
+        return {};
+    }
+
+    const QList<QByteArray> cooked = QConvexDecomposition::cook(
+            vertices, indices, m_hullOptions, *cooking, thePhysics->getPhysicsInsertionCallback());
+    m_convexParts = createConvexMeshes(cooked, *thePhysics);
+    if (m_convexParts.isEmpty()) {
+        // Not retried, decomposing is too expensive to repeat for every rebuild of the shape
+        qCWarning(lcQuick3dPhysics) << "Could not create convex decomposition for" << this;
+        m_cookingFailed[ConvexDecomposition] = true;
+        return {};
+    }
+
+    qCDebug(lcQuick3dPhysics) << "Created" << m_convexParts.size() << "convex hulls for mesh"
+                              << this;
+    if (hash.isEmpty()) {
+        QCacheUtils::writeCachedConvexDecomposition(m_meshPath, cooked, m_hullOptions.key());
+    } else {
+        QQuick3DPhysicsMeshManager::insertConvexDecomposition(hash, m_convexParts);
+        QCacheUtils::writeCachedConvexDecomposition(hash, cooked);
+    }
+    return m_convexParts;
+}
+
 physx::PxConvexMesh *QQuick3DPhysicsMesh::convexMeshQmlSource()
 {
     physx::PxPhysics *thePhysics = QPhysicsWorld::getPhysics();
 
-    m_convexMesh = QCacheUtils::readCachedConvexMesh(m_meshPath, *thePhysics);
+    m_convexMesh = QCacheUtils::readCachedConvexMesh(m_meshPath, *thePhysics, m_hullOptions.key());
     if (m_convexMesh != nullptr)
         return m_convexMesh;
 
@@ -99,21 +349,19 @@ physx::PxConvexMesh *QQuick3DPhysicsMesh::convexMeshQmlSource()
     convexDesc.points.count = vCount;
     convexDesc.points.stride = vStride;
     convexDesc.points.data = m_ssgMesh.vertexBuffer().data.constData() + m_posOffset;
-    convexDesc.flags = physx::PxConvexFlag::eCOMPUTE_CONVEX;
+    m_hullOptions.apply(convexDesc);
 
     // NOTE: Since we are making a mesh for the convex hull and are only
     // interested in the positions we can Skip the index array.
 
-    physx::PxDefaultMemoryOutputStream buf;
-    physx::PxConvexMeshCookingResult::Enum result;
     const auto cooking = QPhysicsWorld::getCooking();
-    if (cooking && cooking->cookConvexMesh(convexDesc, buf, &result)) {
-        auto size = buf.getSize();
-        auto *data = buf.getData();
-        physx::PxDefaultMemoryInputData input(data, size);
-        m_convexMesh = thePhysics->createConvexMesh(input);
+    if (cooking) {
+        m_convexMesh = cookConvexMesh(convexDesc, *cooking, *thePhysics, [this](auto &buf) {
+            QCacheUtils::writeCachedConvexMesh(m_meshPath, buf, m_hullOptions.key());
+        });
+    }
+    if (m_convexMesh) {
         qCDebug(lcQuick3dPhysics) << "Created convex mesh" << m_convexMesh << "for mesh" << this;
-        QCacheUtils::writeCachedConvexMesh(m_meshPath, buf);
     } else {
         qCWarning(lcQuick3dPhysics) << "Could not create convex mesh from" << m_meshPath;
     }
@@ -139,6 +387,18 @@ physx::PxConvexMesh *QQuick3DPhysicsMesh::convexMeshGeometrySource()
             attributeBySemantic(m_meshGeometry, QQuick3DGeometry::Attribute::PositionSemantic);
     Q_ASSERT(vertexAttribute.componentType == QQuick3DGeometry::Attribute::F32Type);
 
+    // Identical geometries share the cooked mesh
+    const QByteArray hash = geometryHash(Convex);
+    m_convexMesh = QQuick3DPhysicsMeshManager::cachedConvexMesh(hash);
+    if (m_convexMesh != nullptr)
+        return m_convexMesh;
+
+    m_convexMesh = QCacheUtils::readCachedConvexMesh(hash, *QPhysicsWorld::getPhysics());
+    if (m_convexMesh != nullptr) {
+        QQuick3DPhysicsMeshManager::insertConvexMesh(hash, m_convexMesh);
+        return m_convexMesh;
+    }
+
     const auto stride = m_meshGeometry->stride();
     const auto numVertices = vertexBuffer.size() / stride;
 
@@ -146,20 +406,21 @@ physx::PxConvexMesh *QQuick3DPhysicsMesh::convexMeshGeometrySource()
     convexDesc.points.count = numVertices;
     convexDesc.points.stride = stride;
     convexDesc.points.data = vertexBuffer.constData() + vertexAttribute.offset;
-    convexDesc.flags = physx::PxConvexFlag::eCOMPUTE_CONVEX;
+    m_hullOptions.apply(convexDesc);
 
     // NOTE: Since we are making a mesh for the convex hull and are only
     // interested in the positions we can Skip the index array.
 
     const auto cooking = QPhysicsWorld::getCooking();
-    physx::PxDefaultMemoryOutputStream buf;
-    physx::PxConvexMeshCookingResult::Enum result;
-    if (cooking && cooking->cookConvexMesh(convexDesc, buf, &result)) {
-        auto size = buf.getSize();
-        auto *data = buf.getData();
-        physx::PxDefaultMemoryInputData input(data, size);
-        m_convexMesh = QPhysicsWorld::getPhysics()->createConvexMesh(input);
+    if (cooking) {
+        m_convexMesh = cookConvexMesh(convexDesc, *cooking, *QPhysicsWorld::getPhysics(),
+                                      [&hash](auto &buf) {
+                                          QCacheUtils::writeCachedConvexMesh(hash, buf);
+                                      });
+    }
+    if (m_convexMesh) {
         qCDebug(lcQuick3dPhysics) << "Created convex mesh" << m_convexMesh << "for mesh" << this;
+        QQuick3DPhysicsMeshManager::insertConvexMesh(hash, m_convexMesh);
     } else {
         qCWarning(lcQuick3dPhysics) << "Could not create convex mesh for" << this;
     }
@@ -171,7 +432,8 @@ physx::PxTriangleMesh *QQuick3DPhysicsMesh::triangleMeshQmlSource()
 {
     physx::PxPhysics *thePhysics = QPhysicsWorld::getPhysics();
 
-    m_triangleMesh = QCacheUtils::readCachedTriangleMesh(m_meshPath, *thePhysics);
+    m_triangleMesh =
+            QCacheUtils::readCachedTriangleMesh(m_meshPath, *thePhysics, m_hullOptions.key());
     if (m_triangleMesh != nullptr)
         return m_triangleMesh;
 
@@ -214,17 +476,19 @@ physx::PxTriangleMesh *QQuick3DPhysicsMesh::triangleMeshQmlSource()
         triangleDesc.triangles.count = indexBuffer.size() / triangleDesc.triangles.stride;
     }
 
-    physx::PxDefaultMemoryOutputStream buf;
-    physx::PxTriangleMeshCookingResult::Enum result;
+    QList<QVector3D> decimatedVertices;
+    QList<quint32> decimatedIndices;
+    decimateTriangles(triangleDesc, m_hullOptions, decimatedVertices, decimatedIndices);
+
     const auto cooking = QPhysicsWorld::getCooking();
-    if (cooking && cooking->cookTriangleMesh(triangleDesc, buf, &result)) {
-        auto size = buf.getSize();
-        auto *data = buf.getData();
-        physx::PxDefaultMemoryInputData input(data, size);
-        m_triangleMesh = thePhysics->createTriangleMesh(input);
+    if (cooking) {
+        m_triangleMesh = cookTriangleMesh(triangleDesc, *cooking, *thePhysics, [this](auto &buf) {
+            QCacheUtils::writeCachedTriangleMesh(m_meshPath, buf, m_hullOptions.key());
+        });
+    }
+    if (m_triangleMesh) {
         qCDebug(lcQuick3dPhysics) << "Created triangle mesh" << m_triangleMesh << "for mesh"
                                   << this;
-        QCacheUtils::writeCachedTriangleMesh(m_meshPath, buf);
     } else {
         qCWarning(lcQuick3dPhysics) << "Could not create triangle mesh from" << m_meshPath;
     }
@@ -250,6 +514,17 @@ physx::PxTriangleMesh *QQuick3DPhysicsMesh::triangleMeshGeometrySource()
             attributeBySemantic(m_meshGeometry, QQuick3DGeometry::Attribute::PositionSemantic);
     Q_ASSERT(vertexAttribute.componentType == QQuick3DGeometry::Attribute::F32Type);
 
+    const QByteArray hash = geometryHash(Triangle);
+    m_triangleMesh = QQuick3DPhysicsMeshManager::cachedTriangleMesh(hash);
+    if (m_triangleMesh != nullptr)
+        return m_triangleMesh;
+
+    m_triangleMesh = QCacheUtils::readCachedTriangleMesh(hash, *QPhysicsWorld::getPhysics());
+    if (m_triangleMesh != nullptr) {
+        QQuick3DPhysicsMeshManager::insertTriangleMesh(hash, m_triangleMesh);
+        return m_triangleMesh;
+    }
+
     const int posOffset = vertexAttribute.offset;
     const auto stride = m_meshGeometry->stride();
     const auto numVertices = vertexBuffer.size() / stride;
@@ -279,16 +554,21 @@ physx::PxTriangleMesh *QQuick3DPhysicsMesh::triangleMeshGeometrySource()
         triangleDesc.triangles.count = indexBuffer.size() / triangleDesc.triangles.stride;
     }
 
-    physx::PxDefaultMemoryOutputStream buf;
-    physx::PxTriangleMeshCookingResult::Enum result;
+    QList<QVector3D> decimatedVertices;
+    QList<quint32> decimatedIndices;
+    decimateTriangles(triangleDesc, m_hullOptions, decimatedVertices, decimatedIndices);
+
     const auto cooking = QPhysicsWorld::getCooking();
-    if (cooking && cooking->cookTriangleMesh(triangleDesc, buf, &result)) {
-        auto size = buf.getSize();
-        auto *data = buf.getData();
-        physx::PxDefaultMemoryInputData input(data, size);
-        m_triangleMesh = QPhysicsWorld::getPhysics()->createTriangleMesh(input);
+    if (cooking) {
+        m_triangleMesh = cookTriangleMesh(triangleDesc, *cooking, *QPhysicsWorld::getPhysics(),
+                                          [&hash](auto &buf) {
+                                              QCacheUtils::writeCachedTriangleMesh(hash, buf);
+                                          });
+    }
+    if (m_triangleMesh) {
         qCDebug(lcQuick3dPhysics) << "Created triangle mesh" << m_triangleMesh << "for mesh"
                                   << this;
+        QQuick3DPhysicsMeshManager::insertTriangleMesh(hash, m_triangleMesh);
     } else {
         qCWarning(lcQuick3dPhysics) << "Could not create triangle mesh for" << this;
     }
@@ -362,24 +642,424 @@ void QQuick3DPhysicsMesh::loadSsgMesh()
         qCWarning(lcQuick3dPhysics) << "Could not read mesh from" << m_meshPath;
 }
 
-QQuick3DPhysicsMesh *QQuick3DPhysicsMeshManager::getMesh(const QUrl &source, QObject *contextObject)
+QQuick3DPhysicsMesh::~QQuick3DPhysicsMesh()
+{
+    // Jobs that are still running finish without a mesh to deliver to
+    for (const auto &job : m_jobs) {
+        if (job)
+            job->m_mesh = nullptr;
+    }
+
+    // Meshes cooked from geometry data are shared through the mesh manager, which keeps them
+    // only as long as some mesh uses them. Without physics they went with it already.
+    if (!m_meshGeometry || !QPhysicsWorld::getPhysics())
+        return;
+    if (m_convexMesh)
+        m_convexMesh->release();
+    if (m_triangleMesh)
+        m_triangleMesh->release();
+    for (auto *part : std::as_const(m_convexParts))
+        part->release();
+    QQuick3DPhysicsMeshManager::evictUnusedGeometryMeshes();
+}
+
+bool QQuick3DPhysicsMesh::isCooked(MeshType type) const
+{
+    switch (type) {
+    case Convex:
+        return m_convexMesh != nullptr;
+    case Triangle:
+        return m_triangleMesh != nullptr;
+    case ConvexDecomposition:
+        return !m_convexParts.isEmpty();
+    }
+    return false;
+}
+
+// Loads a mesh shared by identical geometries, a mesh cached on disk, or a pre-cooked mesh file.
+// Meshes from geometry data are looked up by the hash of the data, the others by the path.
+bool QQuick3DPhysicsMesh::loadCachedMesh(MeshType type, const QByteArray &geometryHash)
+{
+    physx::PxPhysics &physics = *QPhysicsWorld::getPhysics();
+    const bool fromGeometry = !geometryHash.isEmpty();
+
+    switch (type) {
+    case Convex:
+        if (fromGeometry) {
+            m_convexMesh = QQuick3DPhysicsMeshManager::cachedConvexMesh(geometryHash);
+            if (!m_convexMesh) {
+                m_convexMesh = QCacheUtils::readCachedConvexMesh(geometryHash, physics);
+                QQuick3DPhysicsMeshManager::insertConvexMesh(geometryHash, m_convexMesh);
+            }
+        } else {
+            m_convexMesh =
+                    QCacheUtils::readCachedConvexMesh(m_meshPath, physics, m_hullOptions.key());
+            if (!m_convexMesh)
+                m_convexMesh = QCacheUtils::readCookedConvexMesh(m_meshPath, physics);
+        }
+        break;
+    case Triangle:
+        if (fromGeometry) {
+            m_triangleMesh = QQuick3DPhysicsMeshManager::cachedTriangleMesh(geometryHash);
+            if (!m_triangleMesh) {
+                m_triangleMesh = QCacheUtils::readCachedTriangleMesh(geometryHash, physics);
+                QQuick3DPhysicsMeshManager::insertTriangleMesh(geometryHash, m_triangleMesh);
+            }
+        } else {
+            m_triangleMesh =
+                    QCacheUtils::readCachedTriangleMesh(m_meshPath, physics, m_hullOptions.key());
+            if (!m_triangleMesh)
+                m_triangleMesh = QCacheUtils::readCookedTriangleMesh(m_meshPath, physics);
+        }
+        break;
+    case ConvexDecomposition:
+        if (fromGeometry) {
+            m_convexParts = QQuick3DPhysicsMeshManager::cachedConvexDecomposition(geometryHash);
+            if (m_convexParts.isEmpty()) {
+                m_convexParts = QCacheUtils::readCachedConvexDecomposition(geometryHash, physics);
+                QQuick3DPhysicsMeshManager::insertConvexDecomposition(geometryHash, m_convexParts);
+            }
+        } else {
+            m_convexParts = QCacheUtils::readCachedConvexDecomposition(m_meshPath, physics,
+                                                                       m_hullOptions.key());
+        }
+        break;
+    }
+    return isCooked(type);
+}
+
+QQuick3DPhysicsCookingJob *QQuick3DPhysicsMesh::cookingJob(MeshType type)
+{
+    if (isCooked(type))
+        return nullptr;
+
+    auto &job = m_jobs[type];
+    if (job)
+        return job.get();
+
+    if (m_cookingFailed[type])
+        return nullptr;
+
+    physx::PxPhysics *thePhysics = QPhysicsWorld::getPhysics();
+    if (thePhysics == nullptr)
+        return nullptr;
+
+    // Cached and pre-cooked meshes only need to be loaded, which is cheap
+    if (!m_meshGeometry && !m_meshPath.isEmpty() && loadCachedMesh(type, QByteArray()))
+        return nullptr;
+
+    const auto *cooking = QPhysicsWorld::getCooking();
+    if (cooking == nullptr)
+        return nullptr;
+    auto newJob = std::make_shared<QQuick3DPhysicsCookingJob>(type);
+    newJob->m_foundation = StaticPhysXObjects::getReference().foundation;
+    newJob->m_cookingParams = cooking->getParams();
+    newJob->m_insertionCallback = &thePhysics->getPhysicsInsertionCallback();
+    newJob->m_physicsGeneration = StaticPhysXObjects::getReference().physicsGeneration;
+    newJob->m_hullOptions = m_hullOptions;
+
+    if (m_meshGeometry) {
+        // Invalid geometries are left to the synchronous path which reports the error
+        if (m_meshGeometry->primitiveType() != QQuick3DGeometry::PrimitiveType::Triangles
+            || m_meshGeometry->vertexData().isEmpty())
+            return nullptr;
+
+        // Identical geometries share the cooked mesh, which is also cheap to load from disk
+        newJob->m_geometryHash = geometryHash(type);
+        if (loadCachedMesh(type, newJob->m_geometryHash))
+            return nullptr;
+
+        const auto vertexAttribute =
+                attributeBySemantic(m_meshGeometry, QQuick3DGeometry::Attribute::PositionSemantic);
+        newJob->m_vertexData = m_meshGeometry->vertexData();
+        newJob->m_stride = m_meshGeometry->stride();
+        newJob->m_posOffset = vertexAttribute.offset;
+        if (type != Convex && !m_meshGeometry->indexData().isEmpty()) {
+            const auto indexAttribute =
+                    attributeBySemantic(m_meshGeometry, QQuick3DGeometry::Attribute::IndexSemantic);
+            newJob->m_indexData = m_meshGeometry->indexData();
+            newJob->m_u16Indices =
+                    indexAttribute.componentType == QQuick3DGeometry::Attribute::U16Type;
+        }
+    } else if (!m_meshPath.isEmpty()) {
+        // The mesh file is loaded on the worker thread as well
+        newJob->m_meshPath = m_meshPath;
+    } else {
+        return nullptr;
+    }
+
+    newJob->m_mesh = this;
+    job = newJob;
+
+    QThreadPool *pool = StaticPhysXObjects::getReference().cookingPool;
+    Q_ASSERT(pool);
+    pool->start([newJob = std::move(newJob)]() mutable {
+        newJob->run();
+        // Hand the reference to the queued functor so the job is never destroyed on the worker
+        auto *context = newJob.get();
+        QMetaObject::invokeMethod(
+                context, [newJob = std::move(newJob)] { newJob->finish(); },
+                Qt::QueuedConnection);
+    });
+
+    return job.get();
+}
+
+void QQuick3DPhysicsMesh::finishCooking(QQuick3DPhysicsCookingJob *job)
+{
+    const MeshType type = job->type();
+    m_jobs[type].reset();
+
+    // The last world was deleted since the job was started, so the result belongs to a released
+    // physics instance. It is dropped and the mesh is cooked again for the current world.
+    physx::PxPhysics *thePhysics = QPhysicsWorld::getPhysics();
+    if (!thePhysics || job->isStale())
+        return;
+
+    // A mesh that was cooked in the meantime, by this mesh or for an identical geometry, is kept
+    // and the result of the job is dropped
+    const QByteArray &hash = job->m_geometryHash;
+    if (!isCooked(type) && !hash.isEmpty()) {
+        switch (type) {
+        case Convex:
+            m_convexMesh = QQuick3DPhysicsMeshManager::cachedConvexMesh(hash);
+            break;
+        case Triangle:
+            m_triangleMesh = QQuick3DPhysicsMeshManager::cachedTriangleMesh(hash);
+            break;
+        case ConvexDecomposition:
+            m_convexParts = QQuick3DPhysicsMeshManager::cachedConvexDecomposition(hash);
+            break;
+        }
+    }
+    if (isCooked(type))
+        return;
+
+    if (!job->m_success) {
+        static const char *names[] = { "convex mesh", "triangle mesh", "convex decomposition" };
+        qCWarning(lcQuick3dPhysics) << "Could not create" << names[type] << "for" << this;
+        m_cookingFailed[type] = true;
+        return;
+    }
+
+    // Without a cache directory the job cooked the mesh directly, otherwise it is created from
+    // the cooked data
+    physx::PxDefaultMemoryInputData input(job->m_cooked.getData(), job->m_cooked.getSize());
+    switch (type) {
+    case Convex:
+        m_convexMesh = std::exchange(job->m_convexMesh, nullptr);
+        if (!m_convexMesh)
+            m_convexMesh = thePhysics->createConvexMesh(input);
+        qCDebug(lcQuick3dPhysics) << "Created convex mesh" << m_convexMesh << "for mesh" << this;
+        if (!hash.isEmpty())
+            QQuick3DPhysicsMeshManager::insertConvexMesh(hash, m_convexMesh);
+        break;
+    case Triangle:
+        m_triangleMesh = std::exchange(job->m_triangleMesh, nullptr);
+        if (!m_triangleMesh)
+            m_triangleMesh = thePhysics->createTriangleMesh(input);
+        qCDebug(lcQuick3dPhysics) << "Created triangle mesh" << m_triangleMesh << "for mesh"
+                                  << this;
+        if (!hash.isEmpty())
+            QQuick3DPhysicsMeshManager::insertTriangleMesh(hash, m_triangleMesh);
+        break;
+    case ConvexDecomposition:
+        m_convexParts = createConvexMeshes(job->m_cookedParts, *thePhysics);
+        qCDebug(lcQuick3dPhysics) << "Created" << m_convexParts.size() << "convex hulls for mesh"
+                                  << this;
+        if (!hash.isEmpty())
+            QQuick3DPhysicsMeshManager::insertConvexDecomposition(hash, m_convexParts);
+        break;
+    }
+}
+
+QByteArray QQuick3DPhysicsMesh::geometryHash(MeshType type) const
+{
+    Q_ASSERT(m_meshGeometry);
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    static const char *names[] = { "convex", "triangle", "decomposition" };
+    hash.addData(QByteArrayView(names[type]));
+    hash.addData(m_hullOptions.key());
+
+    // Only the positions and, except for convex meshes, the indices affect the cooked mesh
+    const QByteArray vertexData = m_meshGeometry->vertexData();
+    const int stride = m_meshGeometry->stride();
+    const int posOffset =
+            attributeBySemantic(m_meshGeometry, QQuick3DGeometry::Attribute::PositionSemantic)
+                    .offset;
+    constexpr int positionSize = 3 * sizeof(float);
+    if (stride == positionSize && posOffset == 0) {
+        hash.addData(vertexData);
+    } else {
+        QByteArray positions;
+        positions.reserve(vertexData.size() / stride * positionSize);
+        for (qsizetype i = 0; i + posOffset + positionSize <= vertexData.size(); i += stride)
+            positions.append(vertexData.constData() + i + posOffset, positionSize);
+        hash.addData(positions);
+    }
+
+    if (type != Convex && !m_meshGeometry->indexData().isEmpty()) {
+        const auto indexAttribute =
+                attributeBySemantic(m_meshGeometry, QQuick3DGeometry::Attribute::IndexSemantic);
+        const bool u16IndexType =
+                indexAttribute.componentType == QQuick3DGeometry::Attribute::U16Type;
+        hash.addData(u16IndexType ? QByteArrayView("u16") : QByteArrayView("u32"));
+        hash.addData(m_meshGeometry->indexData());
+    }
+
+    return hash.result();
+}
+
+void QQuick3DPhysicsCookingJob::run()
+{
+    if (!m_meshPath.isEmpty()) {
+        const QSSGMesh::Mesh mesh = QSSGBufferManager::loadMeshData(QSSGRenderPath(m_meshPath));
+        if (!mesh.isValid())
+            return;
+
+        m_vertexData = mesh.vertexBuffer().data;
+        m_stride = mesh.vertexBuffer().stride;
+        for (const auto &v : mesh.vertexBuffer().entries) {
+            if (v.name == "attr_pos")
+                m_posOffset = v.offset;
+        }
+        m_indexData = mesh.indexBuffer().data;
+        m_u16Indices =
+                mesh.indexBuffer().componentType == QSSGMesh::Mesh::ComponentType::UnsignedInt16;
+    }
+
+    if (m_stride <= 0 || m_vertexData.isEmpty())
+        return;
+
+    physx::PxCooking *cooking =
+            PxCreateCooking(PX_PHYSICS_VERSION, *m_foundation, m_cookingParams);
+    if (!cooking)
+        return;
+    auto releaseCooking = qScopeGuard([cooking] { cooking->release(); });
+    const auto numVertices = m_vertexData.size() / m_stride;
+
+    if (m_type == QQuick3DPhysicsMesh::ConvexDecomposition) {
+        QList<QVector3D> vertices;
+        QList<quint32> indices;
+        readTriangles(m_vertexData, m_stride, m_posOffset, m_indexData, m_u16Indices, vertices,
+                      indices);
+        m_cookedParts = QConvexDecomposition::cook(vertices, indices, m_hullOptions, *cooking,
+                                                   *m_insertionCallback);
+        m_success = !m_cookedParts.isEmpty();
+        if (m_success && !m_meshPath.isEmpty())
+            QCacheUtils::writeCachedConvexDecomposition(m_meshPath, m_cookedParts,
+                                                        m_hullOptions.key(), &m_cookingParams);
+        else if (m_success)
+            QCacheUtils::writeCachedConvexDecomposition(m_geometryHash, m_cookedParts,
+                                                        &m_cookingParams);
+        return;
+    }
+
+    if (m_type == QQuick3DPhysicsMesh::Convex) {
+        physx::PxConvexMeshDesc convexDesc;
+        convexDesc.points.count = numVertices;
+        convexDesc.points.stride = m_stride;
+        convexDesc.points.data = m_vertexData.constData() + m_posOffset;
+        m_hullOptions.apply(convexDesc);
+
+        if (!QCacheUtils::isEnabled()) {
+            m_convexMesh = cooking->createConvexMesh(convexDesc, *m_insertionCallback);
+            m_success = m_convexMesh != nullptr;
+            return;
+        }
+
+        physx::PxConvexMeshCookingResult::Enum result;
+        m_success = cooking->cookConvexMesh(convexDesc, m_cooked, &result);
+        if (m_success && !m_meshPath.isEmpty())
+            QCacheUtils::writeCachedConvexMesh(m_meshPath, m_cooked, m_hullOptions.key(),
+                                               &m_cookingParams);
+        else if (m_success)
+            QCacheUtils::writeCachedConvexMesh(m_geometryHash, m_cooked, &m_cookingParams);
+        return;
+    }
+
+    physx::PxTriangleMeshDesc triangleDesc;
+    triangleDesc.points.count = numVertices;
+    triangleDesc.points.stride = m_stride;
+    triangleDesc.points.data = m_vertexData.constData() + m_posOffset;
+
+    if (m_indexData.size()) {
+        triangleDesc.triangles.data = m_indexData.constData();
+        if (m_u16Indices) {
+            triangleDesc.flags.set(physx::PxMeshFlag::e16_BIT_INDICES);
+            triangleDesc.triangles.stride = sizeof(quint16) * 3;
+        } else {
+            triangleDesc.triangles.stride = sizeof(quint32) * 3;
+        }
+        triangleDesc.triangles.count = m_indexData.size() / triangleDesc.triangles.stride;
+    }
+
+    QList<QVector3D> decimatedVertices;
+    QList<quint32> decimatedIndices;
+    decimateTriangles(triangleDesc, m_hullOptions, decimatedVertices, decimatedIndices);
+
+    if (!QCacheUtils::isEnabled()) {
+        m_triangleMesh = cooking->createTriangleMesh(triangleDesc, *m_insertionCallback);
+        m_success = m_triangleMesh != nullptr;
+        return;
+    }
+
+    physx::PxTriangleMeshCookingResult::Enum result;
+    m_success = cooking->cookTriangleMesh(triangleDesc, m_cooked, &result);
+    if (m_success && !m_meshPath.isEmpty())
+        QCacheUtils::writeCachedTriangleMesh(m_meshPath, m_cooked, m_hullOptions.key(),
+                                             &m_cookingParams);
+    else if (m_success)
+        QCacheUtils::writeCachedTriangleMesh(m_geometryHash, m_cooked, &m_cookingParams);
+}
+
+bool QQuick3DPhysicsCookingJob::isStale() const
+{
+    return m_physicsGeneration != StaticPhysXObjects::getReference().physicsGeneration;
+}
+
+QQuick3DPhysicsCookingJob::~QQuick3DPhysicsCookingJob()
+{
+    // Directly cooked meshes that were not delivered, unless they went with the physics they were
+    // created with
+    if (isStale())
+        return;
+    if (m_convexMesh)
+        m_convexMesh->release();
+    if (m_triangleMesh)
+        m_triangleMesh->release();
+}
+
+void QQuick3DPhysicsCookingJob::finish()
+{
+    if (m_mesh)
+        m_mesh->finishCooking(this);
+    emit finished();
+}
+
+QQuick3DPhysicsMesh *QQuick3DPhysicsMeshManager::getMesh(const QUrl &source, QObject *contextObject,
+                                                      const QQuick3DPhysicsHullOptions &hullOptions)
 {
     const QString qmlSource = QQuick3DModel::translateMeshSource(source, contextObject);
-    auto *mesh = sourceMeshHash.value(qmlSource);
+    const auto key = qMakePair(qmlSource, hullOptions.key());
+    auto *mesh = sourceMeshHash.value(key);
     if (!mesh) {
-        mesh = new QQuick3DPhysicsMesh(qmlSource);
-        sourceMeshHash[qmlSource] = mesh;
+        mesh = new QQuick3DPhysicsMesh(qmlSource, hullOptions);
+        sourceMeshHash[key] = mesh;
     }
     mesh->ref();
     return mesh;
 }
 
-QQuick3DPhysicsMesh *QQuick3DPhysicsMeshManager::getMesh(QQuick3DGeometry *source)
+QQuick3DPhysicsMesh *QQuick3DPhysicsMeshManager::getMesh(QQuick3DGeometry *source,
+                                                      const QQuick3DPhysicsHullOptions &hullOptions)
 {
-    auto *mesh = geometryMeshHash.value(source);
+    const auto key = qMakePair(source, hullOptions.key());
+    auto *mesh = geometryMeshHash.value(key);
     if (!mesh) {
-        mesh = new QQuick3DPhysicsMesh(source);
-        geometryMeshHash.insert(source, mesh);
+        mesh = new QQuick3DPhysicsMesh(source, hullOptions);
+        geometryMeshHash.insert(key, mesh);
     }
     mesh->ref();
     return mesh;
@@ -391,23 +1071,126 @@ void QQuick3DPhysicsMeshManager::releaseMesh(QQuick3DPhysicsMesh *mesh)
         return;
 
     qCDebug(lcQuick3dPhysics()) << "deleting mesh" << mesh;
-    erase_if(sourceMeshHash, [mesh](std::pair<const QString &, QQuick3DPhysicsMesh *&> h) {
-        return h.second == mesh;
+    erase_if(sourceMeshHash, [mesh](auto h) { return h.second == mesh; });
+    erase_if(geometryMeshHash, [mesh](auto h) { return h.second == mesh; });
+    delete mesh;
+}
+
+physx::PxConvexMesh *QQuick3DPhysicsMeshManager::cachedConvexMesh(const QByteArray &geometryHash)
+{
+    auto *mesh = geometryConvexMeshes.value(geometryHash);
+    if (mesh)
+        mesh->acquireReference();
+    return mesh;
+}
+
+physx::PxTriangleMesh *
+QQuick3DPhysicsMeshManager::cachedTriangleMesh(const QByteArray &geometryHash)
+{
+    auto *mesh = geometryTriangleMeshes.value(geometryHash);
+    if (mesh)
+        mesh->acquireReference();
+    return mesh;
+}
+
+QList<physx::PxConvexMesh *>
+QQuick3DPhysicsMeshManager::cachedConvexDecomposition(const QByteArray &geometryHash)
+{
+    const QList<physx::PxConvexMesh *> parts = geometryConvexDecompositions.value(geometryHash);
+    for (auto *part : parts)
+        part->acquireReference();
+    return parts;
+}
+
+void QQuick3DPhysicsMeshManager::insertConvexMesh(const QByteArray &geometryHash,
+                                                  physx::PxConvexMesh *mesh)
+{
+    if (!mesh || geometryConvexMeshes.contains(geometryHash))
+        return;
+    mesh->acquireReference();
+    geometryConvexMeshes.insert(geometryHash, mesh);
+}
+
+void QQuick3DPhysicsMeshManager::insertTriangleMesh(const QByteArray &geometryHash,
+                                                    physx::PxTriangleMesh *mesh)
+{
+    if (!mesh || geometryTriangleMeshes.contains(geometryHash))
+        return;
+    mesh->acquireReference();
+    geometryTriangleMeshes.insert(geometryHash, mesh);
+}
+
+void QQuick3DPhysicsMeshManager::insertConvexDecomposition(
+        const QByteArray &geometryHash, const QList<physx::PxConvexMesh *> &parts)
+{
+    if (parts.isEmpty() || geometryConvexDecompositions.contains(geometryHash))
+        return;
+    for (auto *part : parts)
+        part->acquireReference();
+    geometryConvexDecompositions.insert(geometryHash, parts);
+}
+
+void QQuick3DPhysicsMeshManager::evictUnusedGeometryMeshes()
+{
+    // A reference count of one is the reference of the table. Shapes that still use a mesh,
+    // such as the ones of pooled actors, hold references of their own.
+    erase_if(geometryConvexMeshes, [](auto entry) {
+        if (entry.second->getReferenceCount() > 1)
+            return false;
+        entry.second->release();
+        return true;
     });
-    erase_if(geometryMeshHash, [mesh](std::pair<QQuick3DGeometry *, QQuick3DPhysicsMesh *&> h) {
-        return h.second == mesh;
+    erase_if(geometryTriangleMeshes, [](auto entry) {
+        if (entry.second->getReferenceCount() > 1)
+            return false;
+        entry.second->release();
+        return true;
     });
-    delete mesh;
+    erase_if(geometryConvexDecompositions, [](auto entry) {
+        const auto &parts = entry.second;
+        if (std::any_of(parts.cbegin(), parts.cend(),
+                        [](auto *part) { return part->getReferenceCount() > 1; }))
+            return false;
+        for (auto *part : parts)
+            part->release();
+        return true;
+    });
+}
+
+void QQuick3DPhysicsMeshManager::releaseGeometryMeshes()
+{
+    for (auto *mesh : std::as_const(geometryConvexMeshes))
+        mesh->release();
+    for (auto *mesh : std::as_const(geometryTriangleMeshes))
+        mesh->release();
+    for (const auto &parts : std::as_const(geometryConvexDecompositions)) {
+        for (auto *part : parts)
+            part->release();
+    }
+    geometryConvexMeshes.clear();
+    geometryTriangleMeshes.clear();
+    geometryConvexDecompositions.clear();
 }
 
-QHash<QString, QQuick3DPhysicsMesh *> QQuick3DPhysicsMeshManager::sourceMeshHash;
-QHash<QQuick3DGeometry *, QQuick3DPhysicsMesh *> QQuick3DPhysicsMeshManager::geometryMeshHash;
+QHash<QPair<QString, QByteArray>, QQuick3DPhysicsMesh *> QQuick3DPhysicsMeshManager::sourceMeshHash;
+QHash<QPair<QQuick3DGeometry *, QByteArray>, QQuick3DPhysicsMesh *>
+        QQuick3DPhysicsMeshManager::geometryMeshHash;
+QHash<QByteArray, physx::PxConvexMesh *> QQuick3DPhysicsMeshManager::geometryConvexMeshes;
+QHash<QByteArray, physx::PxTriangleMesh *> QQuick3DPhysicsMeshManager::geometryTriangleMeshes;
+QHash<QByteArray, QList<physx::PxConvexMesh *>>
+        QQuick3DPhysicsMeshManager::geometryConvexDecompositions;
 
 /////////////////////////////////////////////////////////////////////////////
 
+struct QMeshShape::PartGeometries
+{
+    QList<physx::PxConvexMeshGeometry> geometries;
+};
+
+QMeshShape::QMeshShape() : m_partGeometries(std::make_unique<PartGeometries>()) { }
+
 QMeshShape::~QMeshShape()
 {
-    delete m_convexGeometry;
     if (m_mesh)
         QQuick3DPhysicsMeshManager::releaseMesh(m_mesh);
 }
@@ -416,39 +1199,88 @@ physx::PxGeometry *QMeshShape::getPhysXGeometry()
 {
     if (m_dirtyPhysx || m_scaleDirty)
         updatePhysXGeometry();
-    if (shapeType() == MeshType::CONVEX)
-        return m_convexGeometry;
-    if (shapeType() == MeshType::TRIANGLE)
-        return m_triangleGeometry;
+    return physXGeometry();
+}
 
-    Q_UNREACHABLE_RETURN(nullptr);
+QList<physx::PxGeometry *> QMeshShape::getPhysXGeometries()
+{
+    if (shapeType() != MeshType::DECOMPOSITION)
+        return QAbstractCollisionShape::getPhysXGeometries();
+
+    if (m_dirtyPhysx || m_scaleDirty)
+        updatePhysXGeometry();
+    QList<physx::PxGeometry *> geometries;
+    geometries.reserve(m_partGeometries->geometries.size());
+    for (auto &geometry : m_partGeometries->geometries)
+        geometries.append(&geometry);
+    return geometries;
+}
+
+static QQuick3DPhysicsMesh::MeshType toPhysicsMeshType(QMeshShape::MeshType type)
+{
+    switch (type) {
+    case QMeshShape::MeshType::TRIANGLE:
+        return QQuick3DPhysicsMesh::Triangle;
+    case QMeshShape::MeshType::CONVEX:
+        return QQuick3DPhysicsMesh::Convex;
+    case QMeshShape::MeshType::DECOMPOSITION:
+        return QQuick3DPhysicsMesh::ConvexDecomposition;
+    }
+    Q_UNREACHABLE();
+    return QQuick3DPhysicsMesh::Convex;
 }
 
 void QMeshShape::updatePhysXGeometry()
 {
-    delete m_convexGeometry;
-    delete m_triangleGeometry;
-    m_convexGeometry = nullptr;
-    m_triangleGeometry = nullptr;
+    resetPhysXGeometry();
+    m_partGeometries->geometries.clear();
+    QObject::disconnect(m_cookingConnection);
 
-    if (!m_mesh)
+    if (!m_mesh) {
+        setStatus(Status::Null);
         return;
+    }
 
-    auto *convexMesh = shapeType() == MeshType::CONVEX ? m_mesh->convexMesh() : nullptr;
-    auto *triangleMesh = shapeType() == MeshType::TRIANGLE ? m_mesh->triangleMesh() : nullptr;
-    if (!convexMesh && !triangleMesh)
+    // The shape has no geometry until the job is done, see QPhysXActorBody::buildShapes()
+    const QQuick3DPhysicsMesh::MeshType meshType = toPhysicsMeshType(shapeType());
+    if (m_asynchronous) {
+        auto *job = m_mesh->cookingJob(meshType);
+        if (job) {
+            m_cookingConnection = connect(job, &QQuick3DPhysicsCookingJob::finished, this,
+                                          &QMeshShape::cookingFinished);
+            setStatus(Status::Loading);
+            return;
+        }
+    }
+
+    auto *convexMesh = meshType == QQuick3DPhysicsMesh::Convex ? m_mesh->convexMesh() : nullptr;
+    auto *triangleMesh =
+            meshType == QQuick3DPhysicsMesh::Triangle ? m_mesh->triangleMesh() : nullptr;
+    const QList<physx::PxConvexMesh *> convexParts =
+            meshType == QQuick3DPhysicsMesh::ConvexDecomposition ? m_mesh->convexDecomposition()
+                                                                 : QList<physx::PxConvexMesh *>();
+    if (!convexMesh && !triangleMesh && convexParts.isEmpty()) {
+        // Without a physics instance there is nothing to cook with yet
+        if (QPhysicsWorld::getPhysics() != nullptr)
+            setStatus(Status::Error);
         return;
+    }
 
     auto meshScale = sceneScale();
     physx::PxMeshScale scale(physx::PxVec3(meshScale.x(), meshScale.y(), meshScale.z()),
                              physx::PxQuat(physx::PxIdentity));
 
     if (convexMesh)
-        m_convexGeometry = new physx::PxConvexMeshGeometry(convexMesh, scale);
+        setPhysXGeometry(physx::PxConvexMeshGeometry(convexMesh, scale));
     if (triangleMesh)
-        m_triangleGeometry = new physx::PxTriangleMeshGeometry(triangleMesh, scale);
+        setPhysXGeometry(physx::PxTriangleMeshGeometry(triangleMesh, scale));
+    for (auto *part : convexParts)
+        m_partGeometries->geometries.append(physx::PxConvexMeshGeometry(part, scale));
+    if (!m_partGeometries->geometries.isEmpty())
+        setPhysXGeometry(m_partGeometries->geometries.constFirst());
 
     m_dirtyPhysx = false;
+    setStatus(Status::Ready);
 }
 
 const QUrl &QMeshShape::source() const
@@ -462,21 +1294,12 @@ void QMeshShape::setSource(const QUrl &newSource)
         return;
     m_meshSource = newSource;
 
-    // If we get a new source and our mesh was from the old source
-    // (meaning it was NOT from a geometry) we deref
-    if (m_geometry == nullptr) {
-        QQuick3DPhysicsMeshManager::releaseMesh(m_mesh);
-        m_mesh = nullptr;
-    }
-
-    // Load new mesh only if we don't have a geometry as source
-    if (m_geometry == nullptr && !newSource.isEmpty())
-        m_mesh = QQuick3DPhysicsMeshManager::getMesh(m_meshSource, this);
-
-    updatePhysXGeometry();
-    m_dirtyPhysx = true;
+    // The geometry takes precedence, the mesh of the new source is only loaded without one
+    if (m_geometry == nullptr)
+        reloadMesh();
+    else
+        emit needsRebuild(this);
 
-    emit needsRebuild(this);
     emit sourceChanged();
 }
 
@@ -500,17 +1323,8 @@ void QMeshShape::setGeometry(QQuick3DGeometry *newGeometry)
                 &QMeshShape::geometryContentChanged);
     }
 
-    // New geometry means we get a new mesh so deref the old one
-    QQuick3DPhysicsMeshManager::releaseMesh(m_mesh);
-    m_mesh = nullptr;
-    if (m_geometry != nullptr)
-        m_mesh = QQuick3DPhysicsMeshManager::getMesh(m_geometry);
-    else if (!m_meshSource.isEmpty())
-        m_mesh = QQuick3DPhysicsMeshManager::getMesh(m_meshSource, this);
-
-    updatePhysXGeometry();
-    m_dirtyPhysx = true;
-    emit needsRebuild(this);
+    // New geometry means we get a new mesh
+    reloadMesh();
     emit geometryChanged();
 }
 
@@ -524,12 +1338,67 @@ void QMeshShape::geometryDestroyed(QObject *geometry)
 void QMeshShape::geometryContentChanged()
 {
     Q_ASSERT(m_geometry != nullptr);
+    // Drop the mesh first so that a mesh only used by this shape is created anew
     QQuick3DPhysicsMeshManager::releaseMesh(m_mesh);
-    m_mesh = QQuick3DPhysicsMeshManager::getMesh(m_geometry);
+    m_mesh = QQuick3DPhysicsMeshManager::getMesh(m_geometry, hullOptions());
 
-    updatePhysXGeometry();
     m_dirtyPhysx = true;
     emit needsRebuild(this);
 }
 
+void QMeshShape::reloadMesh()
+{
+    // The new mesh is acquired before the old one is released so that a mesh used by both is
+    // not deleted in between
+    QQuick3DPhysicsMesh *oldMesh = m_mesh;
+    m_mesh = nullptr;
+    if (m_geometry != nullptr)
+        m_mesh = QQuick3DPhysicsMeshManager::getMesh(m_geometry, hullOptions());
+    else if (!m_meshSource.isEmpty())
+        m_mesh = QQuick3DPhysicsMeshManager::getMesh(m_meshSource, this, hullOptions());
+    QQuick3DPhysicsMeshManager::releaseMesh(oldMesh);
+
+    // Updated lazily so that asynchronous is honored regardless of the property order
+    m_dirtyPhysx = true;
+    emit needsRebuild(this);
+}
+
+QQuick3DPhysicsHullOptions QMeshShape::hullOptions() const
+{
+    return {};
+}
+
+bool QMeshShape::asynchronous() const
+{
+    return m_asynchronous;
+}
+
+void QMeshShape::setAsynchronous(bool asynchronous)
+{
+    if (m_asynchronous == asynchronous)
+        return;
+    m_asynchronous = asynchronous;
+    emit asynchronousChanged();
+}
+
+QMeshShape::Status QMeshShape::status() const
+{
+    return m_status;
+}
+
+void QMeshShape::setStatus(Status status)
+{
+    if (m_status == status)
+        return;
+    m_status = status;
+    emit statusChanged();
+}
+
+void QMeshShape::cookingFinished()
+{
+    m_dirtyPhysx = true;
+    updatePhysXGeometry();
+    emit needsRebuild(this);
+}
+
 QT_END_NAMESPACE
@@ -22,6 +22,8 @@
 #include <QtQml/QQmlEngine>
 #include <QtQuick3D/QQuick3DGeometry>
 
+#include <memory>
+
 namespace physx {
 class PxBoxGeometry;
 class PxConvexMesh;
@@ -32,6 +34,7 @@ class PxTriangleMeshGeometry;
 
 QT_BEGIN_NAMESPACE
 class QQuick3DPhysicsMesh;
+struct QQuick3DPhysicsHullOptions;
 
 class Q_QUICK3DPHYSICS_EXPORT QMeshShape : public QAbstractCollisionShape
 {
@@ -39,39 +42,64 @@ class Q_QUICK3DPHYSICS_EXPORT QMeshShape : public QAbstractCollisionShape
     Q_PROPERTY(QUrl source READ source WRITE setSource NOTIFY sourceChanged REVISION(6, 5))
     Q_PROPERTY(QQuick3DGeometry *geometry READ geometry WRITE setGeometry NOTIFY geometryChanged
                        REVISION(6, 7))
+    Q_PROPERTY(bool asynchronous READ asynchronous WRITE setAsynchronous NOTIFY
+                       asynchronousChanged REVISION(6, 10))
+    Q_PROPERTY(Status status READ status NOTIFY statusChanged REVISION(6, 10))
     QML_NAMED_ELEMENT(MeshShape)
     QML_UNCREATABLE("abstract interface")
 
 public:
+    QMeshShape();
     ~QMeshShape();
 
-    enum class MeshType { TRIANGLE, CONVEX };
+    enum class MeshType { TRIANGLE, CONVEX, DECOMPOSITION };
     virtual MeshType shapeType() const = 0;
 
+    enum class Status { Null, Loading, Ready, Error };
+    Q_ENUM(Status)
+
     physx::PxGeometry *getPhysXGeometry() override;
+    QList<physx::PxGeometry *> getPhysXGeometries() override;
 
     Q_REVISION(6, 5) const QUrl &source() const;
     Q_REVISION(6, 5) void setSource(const QUrl &newSource);
     Q_REVISION(6, 7) QQuick3DGeometry *geometry() const;
     Q_REVISION(6, 7) void setGeometry(QQuick3DGeometry *newGeometry);
+    Q_REVISION(6, 10) bool asynchronous() const;
+    Q_REVISION(6, 10) void setAsynchronous(bool asynchronous);
+    Q_REVISION(6, 10) Status status() const;
 
 signals:
     Q_REVISION(6, 5) void sourceChanged();
     Q_REVISION(6, 7) void geometryChanged();
+    Q_REVISION(6, 10) void asynchronousChanged();
+    Q_REVISION(6, 10) void statusChanged();
+
+protected:
+    void reloadMesh();
+    virtual QQuick3DPhysicsHullOptions hullOptions() const;
 
 private slots:
     void geometryDestroyed(QObject *geometry);
     void geometryContentChanged();
+    void cookingFinished();
 
 private:
     void updatePhysXGeometry();
+    void setStatus(Status status);
 
     bool m_dirtyPhysx = false;
-    physx::PxConvexMeshGeometry *m_convexGeometry = nullptr;
-    physx::PxTriangleMeshGeometry *m_triangleGeometry = nullptr;
+    bool m_asynchronous = false;
+    Status m_status = Status::Null;
+    QMetaObject::Connection m_cookingConnection;
     QUrl m_meshSource;
     QQuick3DPhysicsMesh *m_mesh = nullptr;
     QQuick3DGeometry *m_geometry = nullptr;
+    // One geometry per convex hull of a decomposition, the first one is also the geometry
+    // returned by getPhysXGeometry(). Defined in the .cpp file so that this header does not need
+    // the PhysX headers.
+    struct PartGeometries;
+    std::unique_ptr<PartGeometries> m_partGeometries;
 };
 
 QT_END_NAMESPACE
@@ -5,6 +5,7 @@
 #include "qphysicscommands_p.h"
 #include "qphysicsutils_p.h"
 #include "qdynamicrigidbody_p.h"
+#include "physxnode/qphysxmasspropertiescache_p.h"
 #include "PxPhysicsAPI.h"
 
 QT_BEGIN_NAMESPACE
@@ -130,7 +131,11 @@ void QPhysicsCommandSetLinearVelocity::execute(const QDynamicRigidBody &rigidBod
     body.setLinearVelocity(QPhysicsUtils::toPhysXType(linearVelocity));
 }
 
-QPhysicsCommandSetMass::QPhysicsCommandSetMass(float inMass) : QPhysicsCommand(), mass(inMass) { }
+QPhysicsCommandSetMass::QPhysicsCommandSetMass(float inMass,
+                                               QPhysXMassPropertiesCache *inMassCache)
+    : QPhysicsCommand(), mass(inMass), massCache(inMassCache)
+{
+}
 
 void QPhysicsCommandSetMass::execute(const QDynamicRigidBody &rigidBody, physx::PxRigidBody &body)
 {
@@ -140,7 +145,10 @@ void QPhysicsCommandSetMass::execute(const QDynamicRigidBody &rigidBody, physx::
         return;
     }
 
-    physx::PxRigidBodyExt::setMassAndUpdateInertia(body, mass);
+    if (massCache)
+        massCache->setMassAndUpdateInertia(body, mass);
+    else
+        physx::PxRigidBodyExt::setMassAndUpdateInertia(body, mass);
 }
 
 void QPhysicsCommandSetMassAndInertiaTensor::execute(const QDynamicRigidBody &rigidBody,
@@ -185,8 +193,9 @@ void QPhysicsCommandSetMassAndInertiaMatrix::execute(const QDynamicRigidBody &ri
     body.setMassSpaceInertiaTensor(diagTensor);
 }
 
-QPhysicsCommandSetDensity::QPhysicsCommandSetDensity(float inDensity)
-    : QPhysicsCommand(), density(inDensity)
+QPhysicsCommandSetDensity::QPhysicsCommandSetDensity(float inDensity,
+                                                     QPhysXMassPropertiesCache *inMassCache)
+    : QPhysicsCommand(), density(inDensity), massCache(inMassCache)
 {
 }
 
@@ -205,7 +214,10 @@ void QPhysicsCommandSetDensity::execute(const QDynamicRigidBody &rigidBody,
         return;
     }
 
-    physx::PxRigidBodyExt::updateMassAndInertia(body, clampedDensity);
+    if (massCache)
+        massCache->updateMassAndInertia(body, clampedDensity);
+    else
+        physx::PxRigidBodyExt::updateMassAndInertia(body, clampedDensity);
 }
 
 QPhysicsCommandSetIsKinematic::QPhysicsCommandSetIsKinematic(bool inIsKinematic)
@@ -28,6 +28,7 @@ class PxRigidBody;
 QT_BEGIN_NAMESPACE
 
 class QDynamicRigidBody;
+class QPhysXMassPropertiesCache;
 
 class QPhysicsCommand
 {
@@ -121,11 +122,12 @@ private:
 class QPhysicsCommandSetMass : public QPhysicsCommand
 {
 public:
-    QPhysicsCommandSetMass(float inMass);
+    QPhysicsCommandSetMass(float inMass, QPhysXMassPropertiesCache *inMassCache = nullptr);
     void execute(const QDynamicRigidBody &rigidBody, physx::PxRigidBody &body) override;
 
 private:
     float mass;
+    QPhysXMassPropertiesCache *massCache;
 };
 
 class QPhysicsCommandSetMassAndInertiaTensor : public QPhysicsCommand
@@ -153,11 +155,12 @@ private:
 class QPhysicsCommandSetDensity : public QPhysicsCommand
 {
 public:
-    QPhysicsCommandSetDensity(float inDensity);
+    QPhysicsCommandSetDensity(float inDensity, QPhysXMassPropertiesCache *inMassCache = nullptr);
     void execute(const QDynamicRigidBody &rigidBody, physx::PxRigidBody &body) override;
 
 private:
     float density;
+    QPhysXMassPropertiesCache *massCache;
 };
 
 class QPhysicsCommandSetIsKinematic : public QPhysicsCommand
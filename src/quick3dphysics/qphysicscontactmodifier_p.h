@@ -0,0 +1,39 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef QPHYSICSCONTACTMODIFIER_P_H
+#define QPHYSICSCONTACTMODIFIER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtQuick3DPhysics/qtquick3dphysicsglobal.h>
+
+namespace physx {
+class PxContactModifyPair;
+}
+
+QT_BEGIN_NAMESPACE
+
+class Q_QUICK3DPHYSICS_EXPORT QPhysicsContactModifier
+{
+public:
+    virtual ~QPhysicsContactModifier() = default;
+
+    // Called from the simulation threads for every contact pair where one of the shapes
+    // belongs to the filter group this modifier is registered for. shapeIndex is the index
+    // (0 or 1) of that shape in pair.shape.
+    virtual void modifyContacts(physx::PxContactModifyPair &pair, int shapeIndex) = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QPHYSICSCONTACTMODIFIER_P_H
@@ -16,12 +16,22 @@
 //
 
 #include <QtQuick3DPhysics/qtquick3dphysicsglobal.h>
+#include <QtCore/QObject>
 #include <QtGui/QVector3D>
 #include <QtQuick3DUtils/private/qssgmesh_p.h>
 
+#include "cooking/PxCooking.h"
+#include "extensions/PxDefaultStreams.h"
+
+#include <memory>
+
 namespace physx {
 class PxBoxGeometry;
 class PxConvexMesh;
+class PxConvexMeshDesc;
+class PxCooking;
+class PxFoundation;
+class PxPhysicsInsertionCallback;
 class PxConvexMeshGeometry;
 class PxTriangleMesh;
 }
@@ -29,13 +39,45 @@ class PxTriangleMesh;
 QT_BEGIN_NAMESPACE
 
 class QQuick3DGeometry;
+class QQuick3DPhysicsCookingJob;
+
+// How convex hulls are computed. The defaults let PhysX use up to 255 vertices of the input.
+struct QQuick3DPhysicsHullOptions
+{
+    int vertexLimit = 255;
+    // Number of vertices the input is reduced to by k-means clustering, 0 means no reduction
+    int quantizedCount = 0;
+    bool shiftVertices = false;
+    bool planeShifting = false;
+
+    // Only used for convex decompositions
+    int maximumHulls = 8;
+    float maximumConcavity = 0.05f;
+    int resolution = 32;
+
+    // Only used for triangle meshes, 0 disables the respective limit of the decimation
+    int decimationTriangleCount = 0;
+    float decimationTolerance = 0.f;
+
+    bool decimates() const { return decimationTriangleCount > 0 || decimationTolerance > 0.f; }
+    // Identifies the options in cache keys, empty for the default options
+    QByteArray key() const;
+    void apply(physx::PxConvexMeshDesc &desc) const;
+};
 
 class QQuick3DPhysicsMesh
 {
 public:
-    QQuick3DPhysicsMesh(const QString &qmlSource) : m_meshPath(qmlSource) { }
-    QQuick3DPhysicsMesh(const QQuick3DGeometry *geometrySource) : m_meshGeometry(geometrySource) { }
-    ~QQuick3DPhysicsMesh() { }
+    QQuick3DPhysicsMesh(const QString &qmlSource, const QQuick3DPhysicsHullOptions &hullOptions)
+        : m_meshPath(qmlSource), m_hullOptions(hullOptions)
+    {
+    }
+    QQuick3DPhysicsMesh(const QQuick3DGeometry *geometrySource,
+                        const QQuick3DPhysicsHullOptions &hullOptions)
+        : m_meshGeometry(geometrySource), m_hullOptions(hullOptions)
+    {
+    }
+    ~QQuick3DPhysicsMesh();
 
     QList<QVector3D> positions();
 
@@ -54,10 +96,21 @@ public:
 
     physx::PxConvexMesh *convexMesh();
     physx::PxTriangleMesh *triangleMesh();
+    QList<physx::PxConvexMesh *> convexDecomposition();
 
-    enum MeshType { Convex, Triangle };
+    enum MeshType { Convex, Triangle, ConvexDecomposition };
+
+    // Returns the job cooking the mesh on the thread pool, starting it if needed. Returns
+    // nullptr if the mesh is already cooked or can not be cooked asynchronously.
+    QQuick3DPhysicsCookingJob *cookingJob(MeshType type);
 
 private:
+    friend class QQuick3DPhysicsCookingJob;
+
+    void finishCooking(QQuick3DPhysicsCookingJob *job);
+    bool isCooked(MeshType type) const;
+    bool loadCachedMesh(MeshType type, const QByteArray &geometryHash);
+    QByteArray geometryHash(MeshType type) const;
     void loadSsgMesh();
     physx::PxConvexMesh *convexMeshQmlSource();
     physx::PxConvexMesh *convexMeshGeometrySource();
@@ -68,22 +121,96 @@ private:
     const QQuick3DGeometry *m_meshGeometry = nullptr;
     QSSGMesh::Mesh m_ssgMesh;
     int m_posOffset = 0;
+    const QQuick3DPhysicsHullOptions m_hullOptions;
 
     physx::PxConvexMesh *m_convexMesh = nullptr;
     physx::PxTriangleMesh *m_triangleMesh = nullptr;
+    QList<physx::PxConvexMesh *> m_convexParts;
+    std::shared_ptr<QQuick3DPhysicsCookingJob> m_jobs[3];
+    bool m_cookingFailed[3] = {};
     int refCount = 0;
 };
 
+// Cooks a mesh on a worker thread. Without a cache directory the PhysX mesh is created directly on
+// the worker thread, otherwise the cooked data is turned into a PhysX mesh on the thread the job
+// was created on. After that finished() is emitted.
+class QQuick3DPhysicsCookingJob : public QObject
+{
+    Q_OBJECT
+public:
+    explicit QQuick3DPhysicsCookingJob(QQuick3DPhysicsMesh::MeshType type) : m_type(type) { }
+    ~QQuick3DPhysicsCookingJob() override;
+
+    QQuick3DPhysicsMesh::MeshType type() const { return m_type; }
+    // Whether the physics the job was created for has been released since
+    bool isStale() const;
+
+signals:
+    void finished();
+
+private:
+    friend class QQuick3DPhysicsMesh;
+
+    void run();
+    void finish();
+
+    const QQuick3DPhysicsMesh::MeshType m_type;
+    QQuick3DPhysicsMesh *m_mesh = nullptr;
+    // The job cooks with a cooking object of its own, created from a copy of the parameters of
+    // the shared one, so changing the parameters does not wait for running jobs
+    physx::PxFoundation *m_foundation = nullptr;
+    physx::PxCookingParams m_cookingParams { physx::PxTolerancesScale() };
+    physx::PxPhysicsInsertionCallback *m_insertionCallback = nullptr;
+    unsigned int m_physicsGeneration = 0;
+
+    // Input, either a mesh file or a copy of the geometry data and its hash
+    QString m_meshPath;
+    QByteArray m_geometryHash;
+    QQuick3DPhysicsHullOptions m_hullOptions;
+    QByteArray m_vertexData;
+    int m_stride = 0;
+    int m_posOffset = 0;
+    QByteArray m_indexData;
+    bool m_u16Indices = false;
+
+    // Output, convex decompositions are cooked into one buffer per hull
+    physx::PxDefaultMemoryOutputStream m_cooked;
+    physx::PxConvexMesh *m_convexMesh = nullptr;
+    physx::PxTriangleMesh *m_triangleMesh = nullptr;
+    QList<QByteArray> m_cookedParts;
+    bool m_success = false;
+};
+
 class QQuick3DPhysicsMeshManager
 {
 public:
-    static QQuick3DPhysicsMesh *getMesh(const QUrl &source, QObject *contextObject);
-    static QQuick3DPhysicsMesh *getMesh(QQuick3DGeometry *source);
+    static QQuick3DPhysicsMesh *getMesh(const QUrl &source, QObject *contextObject,
+                                        const QQuick3DPhysicsHullOptions &hullOptions = {});
+    static QQuick3DPhysicsMesh *getMesh(QQuick3DGeometry *source,
+                                        const QQuick3DPhysicsHullOptions &hullOptions = {});
     static void releaseMesh(QQuick3DPhysicsMesh *mesh);
 
+    // Meshes cooked from geometry data, shared by all geometries with the same positions and
+    // indices. The tables hold a reference to every mesh, and the lookups acquire one for the
+    // caller. Meshes only the tables refer to are evicted when a geometry mesh is deleted.
+    static physx::PxConvexMesh *cachedConvexMesh(const QByteArray &geometryHash);
+    static physx::PxTriangleMesh *cachedTriangleMesh(const QByteArray &geometryHash);
+    static QList<physx::PxConvexMesh *> cachedConvexDecomposition(const QByteArray &geometryHash);
+    static void insertConvexMesh(const QByteArray &geometryHash, physx::PxConvexMesh *mesh);
+    static void insertTriangleMesh(const QByteArray &geometryHash, physx::PxTriangleMesh *mesh);
+    static void insertConvexDecomposition(const QByteArray &geometryHash,
+                                          const QList<physx::PxConvexMesh *> &parts);
+    static void evictUnusedGeometryMeshes();
+    // Drops the references of the tables, must be called before the physics is released
+    static void releaseGeometryMeshes();
+
 private:
-    static QHash<QString, QQuick3DPhysicsMesh *> sourceMeshHash;
-    static QHash<QQuick3DGeometry *, QQuick3DPhysicsMesh *> geometryMeshHash;
+    // Keyed by the source and the key of the hull options
+    static QHash<QPair<QString, QByteArray>, QQuick3DPhysicsMesh *> sourceMeshHash;
+    static QHash<QPair<QQuick3DGeometry *, QByteArray>, QQuick3DPhysicsMesh *> geometryMeshHash;
+    static QHash<QByteArray, physx::PxConvexMesh *> geometryConvexMeshes;
+    static QHash<QByteArray, physx::PxTriangleMesh *> geometryTriangleMeshes;
+    static QHash<QByteArray, QList<physx::PxConvexMesh *>> geometryConvexDecompositions;
 };
 
 QT_END_NAMESPACE
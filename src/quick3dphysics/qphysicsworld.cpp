@@ -4,6 +4,7 @@
 #include "qphysicsworld_p.h"
 
 #include "physxnode/qabstractphysxnode_p.h"
+#include "physxnode/qphysxdynamicbody_p.h"
 #include "physxnode/qphysxworld_p.h"
 #include "qabstractphysicsnode_p.h"
 #include "qdebugdrawhelper_p.h"
@@ -11,6 +12,7 @@
 #include "qstaticphysxobjects_p.h"
 #include "qboxshape_p.h"
 #include "qsphereshape_p.h"
+#include "qconvexdecompositionshape_p.h"
 #include "qconvexmeshshape_p.h"
 #include "qtrianglemeshshape_p.h"
 #include "qcharactercontroller_p.h"
@@ -28,6 +30,10 @@
 #include <QtQuick3DUtils/private/qssgutils_p.h>
 
 #include <QtEnvironmentVariables>
+#include <QtQml/QJSEngine>
+
+#include <algorithm>
+#include <utility>
 
 #define PHYSX_ENABLE_PVD 0
 
@@ -210,6 +216,149 @@ QT_BEGIN_NAMESPACE
     \sa PhysicsNode::bodyContact
 */
 
+/*!
+    \qmlproperty int PhysicsWorld::dynamicBodyPoolSize
+    \since 6.10
+
+    This property defines how many simulation objects of destroyed \l DynamicRigidBody
+    instances are kept for reuse. When a body is destroyed, its simulation object is parked
+    instead of released, as long as the pool is not full. A new body with the same collision
+    shapes, physics material and filtering settings then reuses a parked object instead of
+    creating a new one. This reduces the cost of scenes that create and destroy many similar
+    bodies, such as projectiles.
+
+    The default value is \c{0}, meaning no pooling.
+*/
+
+/*!
+    \qmlproperty float PhysicsWorld::nodeCreationTimeBudget
+    \since 6.10
+
+    This property defines how much time in milliseconds the physics world may spend per frame on
+    adding new physics nodes to the simulation. Adding a node includes loading and cooking its
+    collision meshes, so adding many nodes at once, for example when loading a level, can take
+    a long time. With a budget, the nodes are added over several frames instead.
+
+    At least one node is added per frame. When all pending nodes have been added,
+    \l pendingNodesCreated is emitted. Use \l nodeCreationOrigin to control the order in which
+    the nodes are added.
+
+    The default value is \c{0}, meaning all new nodes are added in the same frame.
+*/
+
+/*!
+    \qmlproperty Node PhysicsWorld::nodeCreationOrigin
+    \since 6.10
+
+    When \l nodeCreationTimeBudget is set, the new physics nodes closest to this node, for
+    example the camera, are added to the simulation first.
+
+    The default value is \c{null}, meaning the nodes are added in the order they were created.
+*/
+
+/*!
+    \qmlsignal PhysicsWorld::pendingNodesCreated()
+    \since 6.10
+
+    This signal is emitted when all physics nodes waiting to be added to the simulation have
+    been added.
+
+    \sa nodeCreationTimeBudget
+*/
+
+/*!
+    \qmlproperty enumeration PhysicsWorld::cookingMidphase
+    \since 6.10
+
+    This property defines the midphase acceleration structure that is built when a triangle mesh
+    is cooked. The midphase is used to find the triangles of a mesh that overlap another shape.
+
+    \value PhysicsWorld.BVH33
+        The default structure, which has the best cooking performance.
+    \value PhysicsWorld.BVH34
+        A structure with better runtime performance and lower memory usage, at the cost of
+        slower cooking. Recommended for large static meshes. The number of triangles per leaf
+        is set by \l cookingPrimitivesPerLeaf.
+
+    The default value is \c{PhysicsWorld.BVH33}.
+
+    \note The cooking parameters are shared by all physics worlds and only affect meshes that
+    are cooked after they have been set. Meshes that have already been cooked, or that are read
+    from the \l{Qt Quick 3D Physics Cooking}{cooking cache} with other parameters, are not
+    cooked again.
+*/
+
+/*!
+    \qmlproperty int PhysicsWorld::cookingPrimitivesPerLeaf
+    \since 6.10
+
+    This property defines the maximum number of triangles per leaf of the midphase structure
+    when \l cookingMidphase is \c{PhysicsWorld.BVH34}. Fewer triangles per leaf give better
+    runtime performance, more triangles per leaf give faster cooking and smaller meshes.
+
+    The default value is \c{4}.
+
+    Range: \c{[4, 15]}
+*/
+
+/*!
+    \qmlproperty real PhysicsWorld::cookingWeldTolerance
+    \since 6.10
+
+    This property defines the distance below which the vertices of a triangle mesh are welded
+    together when the mesh is cooked. Welding requires \l cookingCleanMesh to be enabled.
+
+    The default value is \c{0}, meaning no welding.
+
+    Range: \c{[0, inf]}
+*/
+
+/*!
+    \qmlproperty bool PhysicsWorld::cookingCleanMesh
+    \since 6.10
+
+    This property defines whether triangle meshes are cleaned when cooked, which removes
+    duplicated and unreferenced vertices and degenerate triangles. Disabling it makes cooking
+    faster but the meshes must then already be clean, or the simulation may misbehave.
+
+    The default value is \c{true}.
+*/
+
+/*!
+    \qmlproperty bool PhysicsWorld::cookingPrecomputeActiveEdges
+    \since 6.10
+
+    This property defines whether the active edges of triangle meshes are computed when cooked.
+    Disabling it makes cooking faster but contact generation against the meshes slower.
+
+    The default value is \c{true}.
+*/
+
+/*!
+    \qmlmethod list<DynamicRigidBody> PhysicsWorld::spawnBodies(DynamicRigidBody templateBody, list<vector3d> positions, list<vector3d> linearVelocities, Node parent)
+    \since 6.10
+
+    Creates one DynamicRigidBody per entry in \a positions and returns them. This is
+    considerably cheaper than creating the bodies one by one with \l Component::createObject(),
+    since no QML component is instantiated and all the bodies are added to the simulation
+    together in the next frame.
+
+    The new bodies copy the properties of \a templateBody, except for the transform,
+    \l {PhysicsBody::simulationEnabled}{simulationEnabled} and
+    \l {DynamicRigidBody::isSleeping}{isSleeping}, so the template can be a disabled body that
+    only serves as a template, and they always start awake. The new bodies share the collision
+    shapes of the template, which keep the scale of the template, so the template has to outlive
+    them. Other children of the template, such as models, and properties declared in QML are not
+    copied.
+
+    The bodies are placed under \a parent, or under the parent of \a templateBody if \a parent
+    is \c null, and \a positions are given in the coordinate system of that node. If
+    \a linearVelocities is not empty, it must have one entry per position and sets the initial
+    linear velocity of each body.
+
+    The returned bodies can be destroyed with \c destroy().
+*/
+
 Q_LOGGING_CATEGORY(lcQuick3dPhysics, "qt.quick3d.physics");
 
 // Setting QT_PHYSICS_TIMINGS_FILE to a filepath will generate a csv file with frame timings.
@@ -438,6 +587,7 @@ QPhysicsWorld::~QPhysicsWorld()
         body->cleanup(m_physx);
         delete body;
     }
+    m_physx->removePendingActors();
     m_physx->deleteWorld();
     delete m_physx;
     worldManager.worlds.removeAll(this);
@@ -727,10 +877,12 @@ void QPhysicsWorld::updateDebugDraw()
                 continue;
             }
 
-            if (node->shapes.length() < length)
+            // Collision shapes that are still being cooked have no PhysX shape yet
+            const qsizetype shapeIdx = node->collisionShapes.indexOf(collisionShape);
+            if (shapeIdx < 0)
                 continue;
 
-            const auto physXShape = node->shapes[idx];
+            const auto physXShape = node->shapes[shapeIdx];
             auto localPose = physXShape->getLocalPose();
 
             switch (physXShape->getGeometryType()) {
@@ -852,8 +1004,18 @@ void QPhysicsWorld::updateDebugDraw()
                         convexMeshGeometry.convexMesh->acquireReference();
                         holder.setConvexMesh(convexMeshGeometry.convexMesh);
                     }
-                    auto geom = QDebugDrawHelper::generateConvexMeshGeometry(
-                            convexMeshGeometry.convexMesh);
+
+                    // The hulls of a convex decomposition follow each other and share the pose
+                    // and the scale, they are drawn as one model
+                    QList<physx::PxConvexMesh *> convexMeshes;
+                    for (qsizetype i = shapeIdx; i < node->shapes.size()
+                         && node->collisionShapes[i] == collisionShape;
+                         i++) {
+                        physx::PxConvexMeshGeometry partGeometry;
+                        if (node->shapes[i]->getConvexMeshGeometry(partGeometry))
+                            convexMeshes.append(partGeometry.convexMesh);
+                    }
+                    auto geom = QDebugDrawHelper::generateConvexMeshGeometry(convexMeshes);
                     geom->setParent(model);
                     model->setGeometry(geom);
                 }
@@ -1043,11 +1205,31 @@ void QPhysicsWorld::updateDebugDrawDesignStudio()
                     holder.setRowScale(heightFieldGeometry->rowScale);
                     holder.setColumnScale(heightFieldGeometry->columnScale);
                 }
+            } else if (auto shape = qobject_cast<QConvexDecompositionShape *>(collisionShape)) {
+                const auto geometries = shape->getPhysXGeometries();
+                if (geometries.isEmpty()) {
+                    if (shape->status() != QMeshShape::Status::Loading)
+                        qWarning() << "Could not get convex decomposition";
+                } else {
+                    const auto *first = static_cast<physx::PxConvexMeshGeometry *>(geometries[0]);
+                    model->setScale(QPhysicsUtils::toQtType(first->scale.scale));
+
+                    if (!hasGeometry) {
+                        QList<physx::PxConvexMesh *> convexMeshes;
+                        for (auto *geometry : geometries)
+                            convexMeshes.append(
+                                    static_cast<physx::PxConvexMeshGeometry *>(geometry)
+                                            ->convexMesh);
+                        newGeometry = QDebugDrawHelper::generateConvexMeshGeometry(convexMeshes);
+                    }
+                }
             } else if (auto shape = qobject_cast<QConvexMeshShape *>(collisionShape)) {
                 auto convexMeshGeometry =
                         static_cast<physx::PxConvexMeshGeometry *>(shape->getPhysXGeometry());
                 if (!convexMeshGeometry) {
-                    qWarning() << "Could not get convex mesh";
+                    // Asynchronously cooked meshes are drawn once they are ready
+                    if (shape->status() != QMeshShape::Status::Loading)
+                        qWarning() << "Could not get convex mesh";
                 } else {
                     model->setScale(QPhysicsUtils::toQtType(convexMeshGeometry->scale.scale));
 
@@ -1060,7 +1242,8 @@ void QPhysicsWorld::updateDebugDrawDesignStudio()
                 physx::PxTriangleMeshGeometry *triangleMeshGeometry =
                         static_cast<physx::PxTriangleMeshGeometry *>(shape->getPhysXGeometry());
                 if (!triangleMeshGeometry) {
-                    qWarning() << "Could not get triangle mesh";
+                    if (shape->status() != QMeshShape::Status::Loading)
+                        qWarning() << "Could not get triangle mesh";
                 } else {
                     model->setScale(QPhysicsUtils::toQtType(triangleMeshGeometry->scale.scale));
 
@@ -1202,20 +1385,74 @@ void QPhysicsWorld::setDefaultDensity(float defaultDensity)
 
 void QPhysicsWorld::cleanupRemovedNodes()
 {
+    m_syncedPhysXBodies.removeIf([](QAbstractPhysXNode *body) { return body->isRemoved; });
     m_physXBodies.removeIf([this](QAbstractPhysXNode *body) {
                                return body->cleanupIfRemoved(m_physx);
                            });
+    m_physx->removePendingActors();
     // We don't need to lock the mutex here since the simulation
     // worker is waiting
     m_removedPhysicsNodes.clear();
 }
 
+void QPhysicsWorld::createNewBackends()
+{
+    if (m_newPhysicsNodes.isEmpty())
+        return;
+
+    const bool hasBudget = m_nodeCreationTimeBudget > 0.f;
+    if (hasBudget && m_nodeCreationOrigin) {
+        // Create the nodes closest to the origin first
+        const QVector3D origin = m_nodeCreationOrigin->scenePosition();
+        QList<std::pair<float, QAbstractPhysicsNode *>> byDistance;
+        byDistance.reserve(m_newPhysicsNodes.size());
+        for (auto *node : std::as_const(m_newPhysicsNodes))
+            byDistance.append({ (node->scenePosition() - origin).lengthSquared(), node });
+        std::stable_sort(byDistance.begin(), byDistance.end(),
+                         [](const auto &a, const auto &b) { return a.first < b.first; });
+        for (qsizetype i = 0; i < byDistance.size(); i++)
+            m_newPhysicsNodes[i] = byDistance[i].second;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const qint64 budgetNs = qint64(m_nodeCreationTimeBudget * 1e6f);
+
+    qsizetype created = 0;
+    while (created < m_newPhysicsNodes.size()) {
+        auto *node = m_newPhysicsNodes[created++];
+        if (node->m_isBatched)
+            continue;
+        auto *body = node->createPhysXBackend();
+        body->init(this, m_physx);
+        // Build the shapes before the actor enters the scene so it is inserted into the broad
+        // phase once with its final bounds
+        body->markDirtyShapes();
+        body->rebuildDirtyShapes(this, m_physx);
+        m_physXBodies.push_back(body);
+        if (body->isSyncedEveryFrame())
+            m_syncedPhysXBodies.push_back(body);
+
+        // At least one node is created per frame, the rest waits for the next frame
+        if (hasBudget && timer.nsecsElapsed() >= budgetNs)
+            break;
+    }
+    m_newPhysicsNodes.remove(0, created);
+    m_physx->addPendingActors();
+
+    if (m_newPhysicsNodes.isEmpty())
+        emit pendingNodesCreated();
+}
+
 void QPhysicsWorld::initPhysics()
 {
     Q_ASSERT(!m_physicsInitialized);
 
     const unsigned int numThreads = m_numThreads >= 0 ? m_numThreads : qMax(0, QThread::idealThreadCount());
     m_physx->createScene(m_typicalLength, m_typicalSpeed, m_gravity, m_enableCCD, this, numThreads);
+    updateCookingParams();
+    m_physx->setContactModifiers(m_contactModifiers);
+    m_contactModifiersDirty = false;
 
     // Setup worker thread
     Q_ASSERT(!m_simulationWorker);
@@ -1242,24 +1479,38 @@ void QPhysicsWorld::frameFinished(float deltaTime)
     matchOrphanNodes();
     emitContactCallbacks();
     cleanupRemovedNodes();
-    for (auto *node : std::as_const(m_newPhysicsNodes)) {
-        auto *body = node->createPhysXBackend();
-        body->init(this, m_physx);
-        m_physXBodies.push_back(body);
+    createNewBackends();
+
+    // Apply the sleep state transitions reported by the last simulation step
+    for (auto *body : std::as_const(m_physx->sleepStateChangedBodies))
+        body->setSleeping(!m_physx->wokenBodies.contains(body));
+    m_physx->sleepStateChangedBodies.clear();
+
+    m_physx->materialRegistry.updateDirtyMaterials();
+
+    if (m_contactModifiersDirty) {
+        m_physx->setContactModifiers(m_contactModifiers);
+        m_contactModifiersDirty = false;
     }
-    m_newPhysicsNodes.clear();
 
     QHash<QQuick3DNode *, QMatrix4x4> transformCache;
 
-    // TODO: Use dirty flag/dirty list to avoid redoing things that didn't change
-    for (auto *physXBody : std::as_const(m_physXBodies)) {
+    const auto syncBody = [&](QAbstractPhysXNode *physXBody) {
         physXBody->markDirtyShapes();
         physXBody->rebuildDirtyShapes(this, m_physx);
         physXBody->updateFilters();
 
         // Sync the physics world and the scene
         physXBody->sync(deltaTime, transformCache);
-    }
+    };
+
+    for (auto *physXBody : std::as_const(m_syncedPhysXBodies))
+        syncBody(physXBody);
+
+    // The other bodies, such as static bodies, are only synced after they changed
+    const QSet<QAbstractPhysXNode *> dirtyBodies = std::exchange(m_physx->dirtyBodies, {});
+    for (auto *physXBody : dirtyBodies)
+        syncBody(physXBody);
 
     updateDebugDraw();
 
@@ -1368,6 +1619,21 @@ void QPhysicsWorld::emitContactCallbacks()
     m_registeredContacts.clear();
 }
 
+void QPhysicsWorld::updatePosePreviews()
+{
+    // Runs on the GUI thread while the simulation step is finishing. The nodes are only deleted
+    // after frameFinished so checking the removed set is enough.
+    const auto *posePreviews = m_physx->posePreviews.consume();
+    if (!posePreviews)
+        return;
+
+    for (const PosePreview &preview : *posePreviews) {
+        if (m_removedPhysicsNodes.contains(preview.node))
+            continue;
+        preview.node->updateFromPhysicsTransform(preview.pose);
+    }
+}
+
 physx::PxPhysics *QPhysicsWorld::getPhysics()
 {
     return StaticPhysXObjects::getReference().physics;
@@ -1378,6 +1644,34 @@ physx::PxCooking *QPhysicsWorld::getCooking()
     return StaticPhysXObjects::getReference().cooking;
 }
 
+void QPhysicsWorld::updateCookingParams()
+{
+    auto &s_physx = StaticPhysXObjects::getReference();
+    if (!s_physx.cooking)
+        return;
+
+    physx::PxCookingParams params = s_physx.cooking->getParams();
+    params.midphaseDesc = m_cookingMidphase == CookingMidphase::BVH34
+            ? physx::PxMeshMidPhase::eBVH34
+            : physx::PxMeshMidPhase::eBVH33;
+    if (m_cookingMidphase == CookingMidphase::BVH34)
+        params.midphaseDesc.mBVH34Desc.numPrimsPerLeaf = m_cookingPrimitivesPerLeaf;
+
+    params.meshWeldTolerance = m_cookingWeldTolerance;
+    params.meshPreprocessParams = physx::PxMeshPreprocessingFlags();
+    if (m_cookingWeldTolerance > 0.f)
+        params.meshPreprocessParams |= physx::PxMeshPreprocessingFlag::eWELD_VERTICES;
+    if (!m_cookingCleanMesh)
+        params.meshPreprocessParams |= physx::PxMeshPreprocessingFlag::eDISABLE_CLEAN_MESH;
+    if (!m_cookingPrecomputeActiveEdges)
+        params.meshPreprocessParams |=
+                physx::PxMeshPreprocessingFlag::eDISABLE_ACTIVE_EDGES_PRECOMPUTE;
+
+    // Asynchronous cooking jobs take a copy of the parameters when they are started, so this
+    // never waits for them
+    s_physx.cooking->setParams(params);
+}
+
 physx::PxControllerManager *QPhysicsWorld::controllerManager()
 {
     if (m_physx->scene && !m_physx->controllerManager) {
@@ -1458,6 +1752,248 @@ void QPhysicsWorld::setReportStaticKinematicCollisions(bool newReportStaticKinem
     emit reportStaticKinematicCollisionsChanged();
 }
 
+float QPhysicsWorld::nodeCreationTimeBudget() const
+{
+    return m_nodeCreationTimeBudget;
+}
+
+void QPhysicsWorld::setNodeCreationTimeBudget(float newNodeCreationTimeBudget)
+{
+    if (qFuzzyCompare(m_nodeCreationTimeBudget, newNodeCreationTimeBudget))
+        return;
+    m_nodeCreationTimeBudget = newNodeCreationTimeBudget;
+    emit nodeCreationTimeBudgetChanged();
+}
+
+QQuick3DNode *QPhysicsWorld::nodeCreationOrigin() const
+{
+    return m_nodeCreationOrigin;
+}
+
+void QPhysicsWorld::setNodeCreationOrigin(QQuick3DNode *newNodeCreationOrigin)
+{
+    if (m_nodeCreationOrigin == newNodeCreationOrigin)
+        return;
+    m_nodeCreationOrigin = newNodeCreationOrigin;
+    emit nodeCreationOriginChanged();
+}
+
+QPhysicsWorld::CookingMidphase QPhysicsWorld::cookingMidphase() const
+{
+    return m_cookingMidphase;
+}
+
+void QPhysicsWorld::setCookingMidphase(CookingMidphase newCookingMidphase)
+{
+    if (m_cookingMidphase == newCookingMidphase)
+        return;
+    m_cookingMidphase = newCookingMidphase;
+    if (m_physicsInitialized)
+        updateCookingParams();
+    emit cookingMidphaseChanged();
+}
+
+int QPhysicsWorld::cookingPrimitivesPerLeaf() const
+{
+    return m_cookingPrimitivesPerLeaf;
+}
+
+void QPhysicsWorld::setCookingPrimitivesPerLeaf(int newCookingPrimitivesPerLeaf)
+{
+    if (newCookingPrimitivesPerLeaf < 4 || newCookingPrimitivesPerLeaf > 15) {
+        qWarning() << "Warning: 'cookingPrimitivesPerLeaf' value outside of [4, 15], ignored";
+        return;
+    }
+    if (m_cookingPrimitivesPerLeaf == newCookingPrimitivesPerLeaf)
+        return;
+    m_cookingPrimitivesPerLeaf = newCookingPrimitivesPerLeaf;
+    if (m_physicsInitialized)
+        updateCookingParams();
+    emit cookingPrimitivesPerLeafChanged();
+}
+
+float QPhysicsWorld::cookingWeldTolerance() const
+{
+    return m_cookingWeldTolerance;
+}
+
+void QPhysicsWorld::setCookingWeldTolerance(float newCookingWeldTolerance)
+{
+    if (newCookingWeldTolerance < 0.f) {
+        qWarning() << "Warning: 'cookingWeldTolerance' value less than zero, ignored";
+        return;
+    }
+    if (qFuzzyCompare(m_cookingWeldTolerance, newCookingWeldTolerance))
+        return;
+    m_cookingWeldTolerance = newCookingWeldTolerance;
+    if (m_physicsInitialized)
+        updateCookingParams();
+    emit cookingWeldToleranceChanged();
+}
+
+bool QPhysicsWorld::cookingCleanMesh() const
+{
+    return m_cookingCleanMesh;
+}
+
+void QPhysicsWorld::setCookingCleanMesh(bool newCookingCleanMesh)
+{
+    if (m_cookingCleanMesh == newCookingCleanMesh)
+        return;
+    m_cookingCleanMesh = newCookingCleanMesh;
+    if (m_physicsInitialized)
+        updateCookingParams();
+    emit cookingCleanMeshChanged();
+}
+
+bool QPhysicsWorld::cookingPrecomputeActiveEdges() const
+{
+    return m_cookingPrecomputeActiveEdges;
+}
+
+void QPhysicsWorld::setCookingPrecomputeActiveEdges(bool newCookingPrecomputeActiveEdges)
+{
+    if (m_cookingPrecomputeActiveEdges == newCookingPrecomputeActiveEdges)
+        return;
+    m_cookingPrecomputeActiveEdges = newCookingPrecomputeActiveEdges;
+    if (m_physicsInitialized)
+        updateCookingParams();
+    emit cookingPrecomputeActiveEdgesChanged();
+}
+
+int QPhysicsWorld::dynamicBodyPoolSize() const
+{
+    return m_physx->actorPool.capacity();
+}
+
+void QPhysicsWorld::setDynamicBodyPoolSize(int newDynamicBodyPoolSize)
+{
+    newDynamicBodyPoolSize = qMax(newDynamicBodyPoolSize, 0);
+    if (m_physx->actorPool.capacity() == newDynamicBodyPoolSize)
+        return;
+    m_physx->actorPool.setCapacity(newDynamicBodyPoolSize);
+    emit dynamicBodyPoolSizeChanged();
+}
+
+/*!
+    \internal
+
+    Registers \a modifier to be called for every contact pair involving a shape in
+    \a filterGroup. Passing \nullptr removes the modifier for that group. The modifier is called
+    from the simulation threads while the step is running and must not touch any QObject. The
+    caller keeps ownership and has to unregister the modifier before deleting it.
+
+    The change takes effect from the next simulation step.
+*/
+void QPhysicsWorld::setContactModifier(int filterGroup, QPhysicsContactModifier *modifier)
+{
+    if (filterGroup < 0 || filterGroup >= int(m_contactModifiers.size())) {
+        qWarning() << "PhysicsWorld: contact modifier filter group" << filterGroup
+                   << "is out of range [0, 31]";
+        return;
+    }
+
+    if (m_contactModifiers[filterGroup] == modifier)
+        return;
+
+    m_contactModifiers[filterGroup] = modifier;
+    m_contactModifiersDirty = true;
+}
+
+QPhysicsContactModifier *QPhysicsWorld::contactModifier(int filterGroup) const
+{
+    if (filterGroup < 0 || filterGroup >= int(m_contactModifiers.size()))
+        return nullptr;
+    return m_contactModifiers[filterGroup];
+}
+
+QList<QDynamicRigidBody *> QPhysicsWorld::spawnBodies(QDynamicRigidBody *templateBody,
+                                                      const QList<QVector3D> &positions,
+                                                      const QList<QVector3D> &linearVelocities,
+                                                      QQuick3DNode *parent)
+{
+    QList<QDynamicRigidBody *> bodies;
+
+    if (!templateBody) {
+        qWarning() << "PhysicsWorld: spawnBodies called without a template body";
+        return bodies;
+    }
+    if (!linearVelocities.isEmpty() && linearVelocities.size() != positions.size()) {
+        qWarning() << "PhysicsWorld: spawnBodies needs one linear velocity per position";
+        return bodies;
+    }
+    if (!parent)
+        parent = templateBody->parentNode();
+    if (!parent) {
+        qWarning() << "PhysicsWorld: spawnBodies called without a parent node";
+        return bodies;
+    }
+
+    // All writable properties of the template are copied, including the ones inherited from Node
+    // and the body base classes, except for the ones skipped here. The transform is skipped since
+    // it is given per body. The template is often disabled, so simulationEnabled is not copied
+    // either, and isSleeping only reports the state of the template's own actor. Lists such as
+    // the collision shapes and the children are handled separately or not at all.
+    static const QList<QByteArrayView> skippedProperties = {
+        "objectName",        "parent",           "state",
+        "x",                 "y",                "z",
+        "position",          "rotation",         "eulerRotation",
+        "kinematicPosition", "kinematicRotation", "kinematicEulerRotation",
+        "simulationEnabled", "isSleeping",
+    };
+    const QMetaObject &metaObject = QDynamicRigidBody::staticMetaObject;
+    QList<QMetaProperty> properties;
+    for (int i = 0; i < metaObject.propertyCount(); i++) {
+        const QMetaProperty property = metaObject.property(i);
+        if (!property.isWritable() || !property.isStored()
+            || skippedProperties.contains(QByteArrayView(property.name()))
+            || QByteArrayView(property.typeName()).startsWith("QQmlListProperty"))
+            continue;
+        properties.append(property);
+    }
+
+    const auto &shapes = templateBody->getCollisionShapesList();
+    const QQuaternion rotation = templateBody->rotation();
+
+    bodies.reserve(positions.size());
+    for (qsizetype i = 0; i < positions.size(); i++) {
+        auto *body = new QDynamicRigidBody();
+        for (const QMetaProperty &property : std::as_const(properties))
+            property.write(body, property.read(templateBody));
+
+        body->setParent(parent);
+        body->setParentItem(parent);
+        body->setPosition(positions[i]);
+        body->setRotation(rotation);
+        if (body->isKinematic()) {
+            body->setKinematicPosition(positions[i]);
+            body->setKinematicRotation(rotation);
+        }
+
+        auto shapeList = body->collisionShapes();
+        for (auto *shape : shapes)
+            shapeList.append(&shapeList, shape);
+
+        if (!linearVelocities.isEmpty())
+            body->setLinearVelocity(linearVelocities[i]);
+
+        // Like objects from Component.createObject(), so that destroy() works
+        QJSEngine::setObjectOwnership(body, QJSEngine::JavaScriptOwnership);
+        bodies.append(body);
+    }
+
+    // The bodies were registered as orphans on construction since they had no parent yet. Hand
+    // them to their world directly instead of waiting for matchOrphanNodes to find them.
+    if (auto *world = getWorld(parent)) {
+        const QSet<QAbstractPhysicsNode *> spawned(bodies.cbegin(), bodies.cend());
+        worldManager.orphanNodes.removeIf(
+                [&spawned](QAbstractPhysicsNode *node) { return spawned.contains(node); });
+        world->m_newPhysicsNodes.append(bodies.cbegin(), bodies.cend());
+    }
+
+    return bodies;
+}
+
 QT_END_NAMESPACE
 
 #include "qphysicsworld.moc"
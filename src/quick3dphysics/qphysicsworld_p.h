@@ -21,11 +21,15 @@
 #include <QtCore/QObject>
 #include <QtCore/QTimerEvent>
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QPointer>
 #include <QtGui/QVector3D>
 #include <QtQml/qqml.h>
 #include <QBasicTimer>
 
+#include <array>
+
 #include <QtQuick3D/private/qquick3dviewport_p.h>
+#include <QtQuick3DPhysics/private/qdynamicrigidbody_p.h>
 
 namespace physx {
 class PxMaterial;
@@ -53,6 +57,7 @@ class QQuick3DModel;
 class QQuick3DGeometry;
 class QQuick3DPrincipledMaterial;
 class QPhysXWorld;
+class QPhysicsContactModifier;
 class SimulationWorker;
 
 class Q_QUICK3DPHYSICS_EXPORT QPhysicsWorld : public QObject, public QQmlParserStatus
@@ -85,10 +90,33 @@ class Q_QUICK3DPHYSICS_EXPORT QPhysicsWorld : public QObject, public QQmlParserS
     Q_PROPERTY(bool reportStaticKinematicCollisions READ reportStaticKinematicCollisions WRITE
                        setReportStaticKinematicCollisions NOTIFY
                                reportStaticKinematicCollisionsChanged FINAL REVISION(6, 7))
+    Q_PROPERTY(int dynamicBodyPoolSize READ dynamicBodyPoolSize WRITE setDynamicBodyPoolSize
+                       NOTIFY dynamicBodyPoolSizeChanged FINAL REVISION(6, 10))
+    Q_PROPERTY(float nodeCreationTimeBudget READ nodeCreationTimeBudget WRITE
+                       setNodeCreationTimeBudget NOTIFY nodeCreationTimeBudgetChanged FINAL
+                               REVISION(6, 10))
+    Q_PROPERTY(QQuick3DNode *nodeCreationOrigin READ nodeCreationOrigin WRITE
+                       setNodeCreationOrigin NOTIFY nodeCreationOriginChanged FINAL
+                               REVISION(6, 10))
+    Q_PROPERTY(CookingMidphase cookingMidphase READ cookingMidphase WRITE setCookingMidphase
+                       NOTIFY cookingMidphaseChanged FINAL REVISION(6, 10))
+    Q_PROPERTY(int cookingPrimitivesPerLeaf READ cookingPrimitivesPerLeaf WRITE
+                       setCookingPrimitivesPerLeaf NOTIFY cookingPrimitivesPerLeafChanged FINAL
+                               REVISION(6, 10))
+    Q_PROPERTY(float cookingWeldTolerance READ cookingWeldTolerance WRITE setCookingWeldTolerance
+                       NOTIFY cookingWeldToleranceChanged FINAL REVISION(6, 10))
+    Q_PROPERTY(bool cookingCleanMesh READ cookingCleanMesh WRITE setCookingCleanMesh NOTIFY
+                       cookingCleanMeshChanged FINAL REVISION(6, 10))
+    Q_PROPERTY(bool cookingPrecomputeActiveEdges READ cookingPrecomputeActiveEdges WRITE
+                       setCookingPrecomputeActiveEdges NOTIFY cookingPrecomputeActiveEdgesChanged
+                               FINAL REVISION(6, 10))
 
     QML_NAMED_ELEMENT(PhysicsWorld)
 
 public:
+    enum class CookingMidphase { BVH33, BVH34 };
+    Q_ENUM(CookingMidphase)
+
     explicit QPhysicsWorld(QObject *parent = nullptr);
     ~QPhysicsWorld();
 
@@ -128,6 +156,30 @@ public:
     Q_REVISION(6, 7) bool reportStaticKinematicCollisions() const;
     Q_REVISION(6, 7)
     void setReportStaticKinematicCollisions(bool newReportStaticKinematicCollisions);
+    Q_REVISION(6, 10) int dynamicBodyPoolSize() const;
+    Q_REVISION(6, 10) void setDynamicBodyPoolSize(int newDynamicBodyPoolSize);
+    Q_REVISION(6, 10) float nodeCreationTimeBudget() const;
+    Q_REVISION(6, 10) void setNodeCreationTimeBudget(float newNodeCreationTimeBudget);
+    Q_REVISION(6, 10) QQuick3DNode *nodeCreationOrigin() const;
+    Q_REVISION(6, 10) void setNodeCreationOrigin(QQuick3DNode *newNodeCreationOrigin);
+    Q_REVISION(6, 10) CookingMidphase cookingMidphase() const;
+    Q_REVISION(6, 10) void setCookingMidphase(CookingMidphase newCookingMidphase);
+    Q_REVISION(6, 10) int cookingPrimitivesPerLeaf() const;
+    Q_REVISION(6, 10) void setCookingPrimitivesPerLeaf(int newCookingPrimitivesPerLeaf);
+    Q_REVISION(6, 10) float cookingWeldTolerance() const;
+    Q_REVISION(6, 10) void setCookingWeldTolerance(float newCookingWeldTolerance);
+    Q_REVISION(6, 10) bool cookingCleanMesh() const;
+    Q_REVISION(6, 10) void setCookingCleanMesh(bool newCookingCleanMesh);
+    Q_REVISION(6, 10) bool cookingPrecomputeActiveEdges() const;
+    Q_REVISION(6, 10) void setCookingPrecomputeActiveEdges(bool newCookingPrecomputeActiveEdges);
+
+    void setContactModifier(int filterGroup, QPhysicsContactModifier *modifier);
+    QPhysicsContactModifier *contactModifier(int filterGroup) const;
+
+    Q_REVISION(6, 10)
+    Q_INVOKABLE QList<QDynamicRigidBody *>
+    spawnBodies(QDynamicRigidBody *templateBody, const QList<QVector3D> &positions,
+                const QList<QVector3D> &linearVelocities = {}, QQuick3DNode *parent = nullptr);
 
 public slots:
     void setGravity(QVector3D gravity);
@@ -160,12 +212,22 @@ signals:
     Q_REVISION(6, 7) void numThreadsChanged();
     Q_REVISION(6, 7) void reportKinematicKinematicCollisionsChanged();
     Q_REVISION(6, 7) void reportStaticKinematicCollisionsChanged();
+    Q_REVISION(6, 10) void dynamicBodyPoolSizeChanged();
+    Q_REVISION(6, 10) void nodeCreationTimeBudgetChanged();
+    Q_REVISION(6, 10) void nodeCreationOriginChanged();
+    Q_REVISION(6, 10) void pendingNodesCreated();
+    Q_REVISION(6, 10) void cookingMidphaseChanged();
+    Q_REVISION(6, 10) void cookingPrimitivesPerLeafChanged();
+    Q_REVISION(6, 10) void cookingWeldToleranceChanged();
+    Q_REVISION(6, 10) void cookingCleanMeshChanged();
+    Q_REVISION(6, 10) void cookingPrecomputeActiveEdgesChanged();
 
 private:
     void frameFinished(float deltaTime);
     void frameFinishedDesignStudio();
     void initPhysics();
     void cleanupRemovedNodes();
+    void createNewBackends();
     void updateDebugDraw();
     void updateDebugDrawDesignStudio();
     void setupDebugMaterials(QQuick3DNode *sceneNode);
@@ -173,6 +235,8 @@ private:
     void matchOrphanNodes();
     void findPhysicsNodes();
     void emitContactCallbacks();
+    void updatePosePreviews();
+    void updateCookingParams();
 
     struct BodyContact
     {
@@ -221,6 +285,8 @@ private:
     };
 
     QList<QAbstractPhysXNode *> m_physXBodies;
+    // The bodies in m_physXBodies that are synced every frame
+    QList<QAbstractPhysXNode *> m_syncedPhysXBodies;
     QList<QAbstractPhysicsNode *> m_newPhysicsNodes;
     QHash<QPair<QAbstractCollisionShape *, QAbstractPhysicsNode *>, DebugModelHolder>
             m_DesignStudioDebugModels;
@@ -229,6 +295,7 @@ private:
     QSet<QAbstractPhysicsNode *> m_removedPhysicsNodes;
     QMutex m_removedPhysicsNodesMutex;
     QList<BodyContact> m_registeredContacts;
+    std::array<QPhysicsContactModifier *, 32> m_contactModifiers {};
 
     QVector3D m_gravity = QVector3D(0.f, -981.f, 0.f);
     float m_typicalLength = 100.f; // 100 cm
@@ -244,6 +311,7 @@ private:
     bool m_hasIndividualDebugDraw = false;
     bool m_physicsInitialized = false;
     bool m_enableCCD = false;
+    bool m_contactModifiersDirty = false;
 
     QPhysXWorld *m_physx = nullptr;
     QQuick3DNode *m_viewport = nullptr;
@@ -264,6 +332,13 @@ private:
     int m_numThreads = -1;
     bool m_reportKinematicKinematicCollisions = false;
     bool m_reportStaticKinematicCollisions = false;
+    float m_nodeCreationTimeBudget = 0.f;
+    QPointer<QQuick3DNode> m_nodeCreationOrigin;
+    CookingMidphase m_cookingMidphase = CookingMidphase::BVH33;
+    int m_cookingPrimitivesPerLeaf = 4;
+    float m_cookingWeldTolerance = 0.f;
+    bool m_cookingCleanMesh = true;
+    bool m_cookingPrecomputeActiveEdges = true;
 };
 
 QT_END_NAMESPACE
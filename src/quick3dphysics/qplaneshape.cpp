@@ -30,24 +30,19 @@ QT_BEGIN_NAMESPACE
 
 QPlaneShape::QPlaneShape() = default;
 
-QPlaneShape::~QPlaneShape()
-{
-    delete m_planeGeometry;
-}
+QPlaneShape::~QPlaneShape() = default;
 
 physx::PxGeometry *QPlaneShape::getPhysXGeometry()
 {
-    if (!m_planeGeometry) {
+    if (!physXGeometry()) {
         updatePhysXGeometry();
     }
-    return m_planeGeometry;
+    return physXGeometry();
 }
 
 void QPlaneShape::updatePhysXGeometry()
 {
-    delete m_planeGeometry;
-    // TODO: we need only one plane geometry, and it should live in the backend
-    m_planeGeometry = new physx::PxPlaneGeometry();
+    setPhysXGeometry(physx::PxPlaneGeometry());
 }
 
 QT_END_NAMESPACE
@@ -21,10 +21,6 @@
 #include <QtGui/QVector3D>
 #include <QtQml/QQmlEngine>
 
-namespace physx {
-class PxPlaneGeometry;
-}
-
 QT_BEGIN_NAMESPACE
 
 class Q_QUICK3DPHYSICS_EXPORT QPlaneShape : public QAbstractCollisionShape
@@ -41,8 +37,6 @@ public:
 
 private:
     void updatePhysXGeometry();
-
-    physx::PxPlaneGeometry *m_planeGeometry = nullptr;
 };
 
 QT_END_NAMESPACE
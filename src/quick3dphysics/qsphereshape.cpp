@@ -29,10 +29,7 @@ QT_BEGIN_NAMESPACE
 
 QSphereShape::QSphereShape() = default;
 
-QSphereShape::~QSphereShape()
-{
-    delete m_physXGeometry;
-}
+QSphereShape::~QSphereShape() = default;
 
 float QSphereShape::diameter() const
 {
@@ -41,10 +38,10 @@ float QSphereShape::diameter() const
 
 physx::PxGeometry *QSphereShape::getPhysXGeometry()
 {
-    if (!m_physXGeometry || m_scaleDirty) {
+    if (!physXGeometry() || m_scaleDirty) {
         updatePhysXGeometry();
     }
-    return m_physXGeometry;
+    return physXGeometry();
 }
 
 void QSphereShape::setDiameter(float diameter)
@@ -61,9 +58,8 @@ void QSphereShape::setDiameter(float diameter)
 
 void QSphereShape::updatePhysXGeometry()
 {
-    delete m_physXGeometry;
     auto s = sceneScale();
-    m_physXGeometry = new physx::PxSphereGeometry(m_diameter * 0.5f * s.x());
+    setPhysXGeometry(physx::PxSphereGeometry(m_diameter * 0.5f * s.x()));
     m_scaleDirty = false;
 }
 
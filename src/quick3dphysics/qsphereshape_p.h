@@ -18,10 +18,6 @@
 #include <QtQuick3DPhysics/private/qabstractcollisionshape_p.h>
 #include <QtQml/QQmlEngine>
 
-namespace physx {
-class PxSphereGeometry;
-};
-
 QT_BEGIN_NAMESPACE
 
 class Q_QUICK3DPHYSICS_EXPORT QSphereShape : public QAbstractCollisionShape
@@ -46,7 +42,6 @@ Q_SIGNALS:
 
 private:
     void updatePhysXGeometry();
-    physx::PxSphereGeometry *m_physXGeometry = nullptr;
     float m_diameter = 100.0f;
 };
 
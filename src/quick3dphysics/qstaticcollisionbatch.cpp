@@ -0,0 +1,284 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "qstaticcollisionbatch_p.h"
+
+#include "qboxshape_p.h"
+#include "qconvexmeshshape_p.h"
+#include "qphysicsutils_p.h"
+#include "qtrianglemeshshape_p.h"
+
+#include "geometry/PxBoxGeometry.h"
+#include "geometry/PxConvexMesh.h"
+#include "geometry/PxConvexMeshGeometry.h"
+#include "geometry/PxTriangleMesh.h"
+#include "geometry/PxTriangleMeshGeometry.h"
+
+#include <QtQuick3D/QQuick3DGeometry>
+#include <QtCore/QVarLengthArray>
+
+#include <iterator>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \qmltype StaticCollisionBatch
+    \inqmlmodule QtQuick3D.Physics
+    \inherits StaticRigidBody
+    \since 6.10
+    \brief Merges the static bodies below it into a single triangle mesh.
+
+    The StaticCollisionBatch type is a StaticRigidBody that bakes the collision shapes of the
+    static rigid bodies in its subtree into one triangle mesh. Instead of one PhysX actor per
+    body, the whole subtree is simulated as a single actor with a single shape, which reduces
+    the broad phase and scene update cost of levels built from many static pieces.
+
+    A StaticRigidBody is baked into the batch if all of its collision shapes are a BoxShape, a
+    ConvexMeshShape, a ConvexDecompositionShape or a TriangleMeshShape, and none of its mesh
+    shapes is cooked \l{TriangleMeshShape::asynchronous}{asynchronously}. Bodies with other
+    shapes, nested StaticCollisionBatch objects and the bodies below them are simulated as usual.
+
+    The batch is baked once, when it is added to the physics world. Baked bodies use the
+    \l {PhysicsBody::physicsMaterial}{physicsMaterial} and the filtering settings of the batch,
+    they do not send or receive contact reports, and changing them or their collision shapes
+    after the batch has been baked has no effect on the simulation. Bodies added to the subtree
+    later are not baked.
+
+    Boxes and convex meshes become one-sided, hollow triangle geometry when they are baked. A body
+    that gets pushed deeper than their surface, for instance by a fast impact, is not pushed back
+    out like it would be with the original solid shapes, and can end up inside or fall through.
+
+    \note Do not move a StaticCollisionBatch or any of the bodies baked into it.
+*/
+
+static bool isBatchable(const QStaticRigidBody *body)
+{
+    const auto &shapes = body->getCollisionShapesList();
+    if (shapes.isEmpty())
+        return false;
+
+    for (const auto *shape : shapes) {
+        if (!qobject_cast<const QBoxShape *>(shape)
+            && !qobject_cast<const QConvexMeshShape *>(shape)
+            && !qobject_cast<const QTriangleMeshShape *>(shape))
+            return false;
+        // The batch is baked once and can not wait for asynchronously cooked meshes
+        auto *meshShape = qobject_cast<const QMeshShape *>(shape);
+        if (meshShape && meshShape->asynchronous())
+            return false;
+    }
+    return true;
+}
+
+// Collects triangles in the local space of the batch
+class TriangleCollector
+{
+public:
+    TriangleCollector(const physx::PxTransform &batchPose, const QVector3D &batchScale)
+        : m_batchPose(batchPose), m_batchScale(batchScale)
+    {
+    }
+
+    void setShapePose(const physx::PxTransform &shapePose, bool flipWinding)
+    {
+        m_shapePose = shapePose;
+        m_flipWinding = flipWinding;
+    }
+
+    quint32 addVertex(const physx::PxVec3 &vertex)
+    {
+        const physx::PxVec3 local = m_batchPose.transformInv(m_shapePose.transform(vertex));
+        m_vertices.append(QPhysicsUtils::toQtType(local) / m_batchScale);
+        return quint32(m_vertices.size() - 1);
+    }
+
+    void addTriangle(quint32 a, quint32 b, quint32 c)
+    {
+        if (m_flipWinding)
+            std::swap(b, c);
+        m_indices << a << b << c;
+    }
+
+    const QVector<QVector3D> &vertices() const { return m_vertices; }
+    const QVector<quint32> &indices() const { return m_indices; }
+
+private:
+    physx::PxTransform m_batchPose;
+    QVector3D m_batchScale;
+    physx::PxTransform m_shapePose;
+    bool m_flipWinding = false;
+    QVector<QVector3D> m_vertices;
+    QVector<quint32> m_indices;
+};
+
+static void addBox(TriangleCollector &collector, const physx::PxBoxGeometry &box)
+{
+    // Corner i has the sign of bit 0, 1 and 2 for x, y and z respectively
+    static constexpr quint32 faces[] = { 0, 4, 6, 0, 6, 2, 1, 3, 7, 1, 7, 5, 0, 1, 5, 0, 5, 4,
+                                         2, 6, 7, 2, 7, 3, 0, 2, 3, 0, 3, 1, 4, 5, 7, 4, 7, 6 };
+    const physx::PxVec3 &h = box.halfExtents;
+
+    quint32 corners[8];
+    for (int i = 0; i < 8; i++) {
+        corners[i] = collector.addVertex(
+                physx::PxVec3(i & 1 ? h.x : -h.x, i & 2 ? h.y : -h.y, i & 4 ? h.z : -h.z));
+    }
+
+    for (size_t i = 0; i < std::size(faces); i += 3)
+        collector.addTriangle(corners[faces[i]], corners[faces[i + 1]], corners[faces[i + 2]]);
+}
+
+static void addConvexMesh(TriangleCollector &collector, const physx::PxConvexMeshGeometry &convex)
+{
+    const physx::PxConvexMesh *mesh = convex.convexMesh;
+    const physx::PxVec3 *verts = mesh->getVertices();
+    const physx::PxU8 *polygons = mesh->getIndexBuffer();
+
+    QVarLengthArray<quint32, 64> indices;
+    for (physx::PxU32 i = 0; i < mesh->getNbVertices(); i++)
+        indices.append(collector.addVertex(convex.scale.transform(verts[i])));
+
+    physx::PxHullPolygon data;
+    for (physx::PxU32 i = 0; i < mesh->getNbPolygons(); i++) {
+        mesh->getPolygonData(i, data);
+        Q_ASSERT(data.mNbVerts > 2);
+
+        const quint32 vref0 = indices[polygons[data.mIndexBase]];
+        for (physx::PxU32 j = 1; j + 1 < data.mNbVerts; j++) {
+            collector.addTriangle(vref0, indices[polygons[data.mIndexBase + j]],
+                                  indices[polygons[data.mIndexBase + j + 1]]);
+        }
+    }
+}
+
+static void addTriangleMesh(TriangleCollector &collector,
+                            const physx::PxTriangleMeshGeometry &geometry)
+{
+    const physx::PxTriangleMesh *mesh = geometry.triangleMesh;
+    const physx::PxVec3 *verts = mesh->getVertices();
+    const bool u16Indices =
+            mesh->getTriangleMeshFlags() & physx::PxTriangleMeshFlag::e16_BIT_INDICES;
+
+    const quint32 base = quint32(collector.vertices().size());
+    for (physx::PxU32 i = 0; i < mesh->getNbVertices(); i++)
+        collector.addVertex(geometry.scale.transform(verts[i]));
+
+    for (physx::PxU32 i = 0; i < mesh->getNbTriangles() * 3; i += 3) {
+        if (u16Indices) {
+            const auto *tris = static_cast<const physx::PxU16 *>(mesh->getTriangles());
+            collector.addTriangle(base + tris[i], base + tris[i + 1], base + tris[i + 2]);
+        } else {
+            const auto *tris = static_cast<const physx::PxU32 *>(mesh->getTriangles());
+            collector.addTriangle(base + tris[i], base + tris[i + 1], base + tris[i + 2]);
+        }
+    }
+}
+
+QStaticCollisionBatch::QStaticCollisionBatch() = default;
+
+QAbstractPhysXNode *QStaticCollisionBatch::createPhysXBackend()
+{
+    bake();
+    return QStaticRigidBody::createPhysXBackend();
+}
+
+void QStaticCollisionBatch::componentComplete()
+{
+    QStaticRigidBody::componentComplete();
+
+    // Claim the bodies before the physics world creates their backends. The baking itself has
+    // to wait until the world is initialized since it needs to load the meshes.
+    for (auto *child : childItems())
+        collectBodies(child);
+}
+
+void QStaticCollisionBatch::collectBodies(QQuick3DObject *object)
+{
+    if (qobject_cast<QStaticCollisionBatch *>(object))
+        return;
+
+    if (auto *body = qobject_cast<QStaticRigidBody *>(object)) {
+        // Bodies that already have a backend are left alone
+        if (!body->m_backendObject && isBatchable(body)) {
+            body->m_isBatched = true;
+            m_batchedBodies.append(body);
+        }
+    }
+
+    for (auto *child : object->childItems())
+        collectBodies(child);
+}
+
+void QStaticCollisionBatch::bake()
+{
+    if (m_bakedShape || m_batchedBodies.isEmpty())
+        return;
+
+    TriangleCollector collector(QPhysicsUtils::toPhysXTransform(scenePosition(), sceneRotation()),
+                                sceneScale());
+
+    for (const auto &body : std::as_const(m_batchedBodies)) {
+        if (!body)
+            continue;
+
+        const physx::PxTransform bodyPose =
+                QPhysicsUtils::toPhysXTransform(body->scenePosition(), body->sceneRotation());
+
+        for (auto *shape : body->getCollisionShapesList()) {
+            const QVector3D scale = shape->sceneScale();
+            const physx::PxTransform shapePose = bodyPose
+                    * QPhysicsUtils::toPhysXTransform(shape->position() * scale, shape->rotation());
+            const bool flipWinding = (scale.x() * scale.y() * scale.z() < 0)
+                    != (sceneScale().x() * sceneScale().y() * sceneScale().z() < 0);
+            collector.setShapePose(shapePose, flipWinding);
+
+            // A ConvexDecompositionShape has one geometry per convex hull
+            for (const physx::PxGeometry *geometry : shape->getPhysXGeometries()) {
+                switch (geometry->getType()) {
+                case physx::PxGeometryType::eBOX:
+                    addBox(collector, static_cast<const physx::PxBoxGeometry &>(*geometry));
+                    break;
+                case physx::PxGeometryType::eCONVEXMESH:
+                    addConvexMesh(collector,
+                                  static_cast<const physx::PxConvexMeshGeometry &>(*geometry));
+                    break;
+                case physx::PxGeometryType::eTRIANGLEMESH:
+                    addTriangleMesh(collector,
+                                    static_cast<const physx::PxTriangleMeshGeometry &>(*geometry));
+                    break;
+                default:
+                    Q_UNREACHABLE();
+                }
+            }
+        }
+    }
+    m_batchedBodies.clear();
+
+    if (collector.indices().isEmpty())
+        return;
+
+    const auto &vertices = collector.vertices();
+    const auto &indices = collector.indices();
+
+    m_bakedGeometry = new QQuick3DGeometry(this);
+    m_bakedGeometry->setPrimitiveType(QQuick3DGeometry::PrimitiveType::Triangles);
+    m_bakedGeometry->setStride(sizeof(QVector3D));
+    m_bakedGeometry->addAttribute(QQuick3DGeometry::Attribute::PositionSemantic, 0,
+                                  QQuick3DGeometry::Attribute::F32Type);
+    m_bakedGeometry->addAttribute(QQuick3DGeometry::Attribute::IndexSemantic, 0,
+                                  QQuick3DGeometry::Attribute::U32Type);
+    m_bakedGeometry->setVertexData(QByteArray(reinterpret_cast<const char *>(vertices.constData()),
+                                              vertices.size() * sizeof(QVector3D)));
+    m_bakedGeometry->setIndexData(QByteArray(reinterpret_cast<const char *>(indices.constData()),
+                                             indices.size() * sizeof(quint32)));
+
+    m_bakedShape = new QTriangleMeshShape();
+    m_bakedShape->setParent(this);
+    m_bakedShape->setParentItem(this);
+    m_bakedShape->setGeometry(m_bakedGeometry);
+
+    auto shapes = collisionShapes();
+    shapes.append(&shapes, m_bakedShape);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,50 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef QSTATICCOLLISIONBATCH_P_H
+#define QSTATICCOLLISIONBATCH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtQuick3DPhysics/private/qstaticrigidbody_p.h>
+#include <QtCore/QPointer>
+#include <QtQml/QQmlEngine>
+
+QT_BEGIN_NAMESPACE
+
+class QQuick3DGeometry;
+class QTriangleMeshShape;
+
+class Q_QUICK3DPHYSICS_EXPORT QStaticCollisionBatch : public QStaticRigidBody
+{
+    Q_OBJECT
+    QML_NAMED_ELEMENT(StaticCollisionBatch)
+public:
+    QStaticCollisionBatch();
+
+    QAbstractPhysXNode *createPhysXBackend() override;
+
+protected:
+    void componentComplete() override;
+
+private:
+    void collectBodies(QQuick3DObject *object);
+    void bake();
+
+    QList<QPointer<QStaticRigidBody>> m_batchedBodies;
+    QQuick3DGeometry *m_bakedGeometry = nullptr;
+    QTriangleMeshShape *m_bakedShape = nullptr;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSTATICCOLLISIONBATCH_P_H
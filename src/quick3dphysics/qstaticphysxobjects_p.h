@@ -30,6 +30,8 @@ class PxCooking;
 
 QT_BEGIN_NAMESPACE
 
+class QThreadPool;
+
 struct StaticPhysXObjects
 {
     physx::PxDefaultErrorCallback defaultErrorCallback;
@@ -40,6 +42,12 @@ struct StaticPhysXObjects
     physx::PxPhysics *physics = nullptr;
     physx::PxDefaultCpuDispatcher *dispatcher = nullptr;
     physx::PxCooking *cooking = nullptr;
+    // Runs the asynchronous cooking jobs, lives as long as the physics so that it can be drained
+    // before the foundation and physics are released
+    QThreadPool *cookingPool = nullptr;
+    // Incremented whenever the physics is released, so that results created with a released
+    // physics instance can be told apart from results of the current one
+    unsigned int physicsGeneration = 0;
 
     unsigned int foundationRefCount = 0;
     bool foundationCreated = false;
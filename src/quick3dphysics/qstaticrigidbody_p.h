@@ -26,7 +26,7 @@ class Q_QUICK3DPHYSICS_EXPORT QStaticRigidBody : public QAbstractPhysicsBody
     QML_NAMED_ELEMENT(StaticRigidBody)
 public:
     QStaticRigidBody();
-    QAbstractPhysXNode *createPhysXBackend() final;
+    QAbstractPhysXNode *createPhysXBackend() override;
 };
 
 QT_END_NAMESPACE
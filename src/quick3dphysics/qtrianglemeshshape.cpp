@@ -44,6 +44,72 @@ QT_BEGIN_NAMESPACE
     \since 6.7
 */
 
+/*!
+    \qmlproperty bool TriangleMeshShape::asynchronous
+    \since 6.10
+
+    This property holds whether the mesh is cooked on a worker thread. Cooking a detailed mesh
+    can take a long time, and when this property is \c false it happens on the GUI thread the
+    first time the shape is used by the physics world.
+
+    While the mesh is being cooked the \l{TriangleMeshShape::}{status} is
+    \c MeshShape.Loading and the body the shape belongs to does not take part in the simulation.
+
+    Meshes that are already cooked, either in advance or in the cache, are loaded immediately.
+
+    Default value: \c false
+*/
+
+/*!
+    \qmlproperty enumeration TriangleMeshShape::status
+    \readonly
+    \since 6.10
+
+    This property holds the status of the mesh:
+
+    \value MeshShape.Null No mesh has been set, or the physics world does not exist yet.
+    \value MeshShape.Loading The mesh is being cooked, see \l{TriangleMeshShape::}{asynchronous}.
+    \value MeshShape.Ready The mesh is ready to be used by the simulation.
+    \value MeshShape.Error The mesh could not be loaded or cooked.
+*/
+
+/*!
+    \qmlproperty int TriangleMeshShape::decimationTriangleCount
+    \since 6.10
+
+    When this property is larger than \c 0, the mesh is simplified to at most this number of
+    triangles before it is cooked. Render meshes often have far more triangles than are needed
+    for collisions, and a simpler mesh is faster to cook and to collide with.
+
+    The simplification collapses the edges that change the shape of the mesh the least first,
+    and keeps the outline of open meshes. It stops early when \l decimationTolerance is set and
+    the next collapse would exceed it.
+
+    The simplified mesh is stored in the cache directory like other cooked meshes. Pre-cooked
+    meshes are loaded as they are, see the \l{Qt Quick 3D Physics Cooking}{cooking overview
+    documentation} for how to simplify them with the cooker tool.
+
+    Default value: \c 0, meaning the number of triangles is not limited.
+
+    Range: \c{[0, inf]}
+*/
+
+/*!
+    \qmlproperty real TriangleMeshShape::decimationTolerance
+    \since 6.10
+
+    When this property is larger than \c 0, the mesh is simplified before it is cooked for as
+    long as the surface moves less than about this distance, in the units of the mesh. Flat and
+    gently curved regions are reduced to a few triangles while sharp features are kept.
+
+    When \l decimationTriangleCount is set as well, the simplification stops at whichever limit
+    is reached first.
+
+    Default value: \c 0, meaning the simplification is not limited by the distance.
+
+    Range: \c{[0, inf]}
+*/
+
 QMeshShape::MeshType QTriangleMeshShape::shapeType() const
 {
     return QMeshShape::MeshType::TRIANGLE;
@@ -54,4 +120,48 @@ bool QTriangleMeshShape::isStaticShape() const
     return true;
 }
 
+int QTriangleMeshShape::decimationTriangleCount() const
+{
+    return m_decimationTriangleCount;
+}
+
+void QTriangleMeshShape::setDecimationTriangleCount(int newDecimationTriangleCount)
+{
+    if (newDecimationTriangleCount < 0) {
+        qWarning() << "Warning: 'decimationTriangleCount' value outside of [0, inf], ignored";
+        return;
+    }
+    if (m_decimationTriangleCount == newDecimationTriangleCount)
+        return;
+    m_decimationTriangleCount = newDecimationTriangleCount;
+    reloadMesh();
+    emit decimationTriangleCountChanged();
+}
+
+float QTriangleMeshShape::decimationTolerance() const
+{
+    return m_decimationTolerance;
+}
+
+void QTriangleMeshShape::setDecimationTolerance(float newDecimationTolerance)
+{
+    if (newDecimationTolerance < 0) {
+        qWarning() << "Warning: 'decimationTolerance' value outside of [0, inf], ignored";
+        return;
+    }
+    if (qFuzzyCompare(m_decimationTolerance, newDecimationTolerance))
+        return;
+    m_decimationTolerance = newDecimationTolerance;
+    reloadMesh();
+    emit decimationToleranceChanged();
+}
+
+QQuick3DPhysicsHullOptions QTriangleMeshShape::hullOptions() const
+{
+    QQuick3DPhysicsHullOptions options;
+    options.decimationTriangleCount = m_decimationTriangleCount;
+    options.decimationTolerance = m_decimationTolerance;
+    return options;
+}
+
 QT_END_NAMESPACE
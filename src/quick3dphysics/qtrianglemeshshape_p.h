@@ -22,9 +22,31 @@ QT_BEGIN_NAMESPACE
 class Q_QUICK3DPHYSICS_EXPORT QTriangleMeshShape : public QMeshShape
 {
     Q_OBJECT
+    Q_PROPERTY(int decimationTriangleCount READ decimationTriangleCount WRITE
+                       setDecimationTriangleCount NOTIFY decimationTriangleCountChanged FINAL
+                               REVISION(6, 10))
+    Q_PROPERTY(float decimationTolerance READ decimationTolerance WRITE setDecimationTolerance
+                       NOTIFY decimationToleranceChanged FINAL REVISION(6, 10))
     QML_NAMED_ELEMENT(TriangleMeshShape)
+public:
     virtual QMeshShape::MeshType shapeType() const override;
     virtual bool isStaticShape() const override;
+
+    Q_REVISION(6, 10) int decimationTriangleCount() const;
+    Q_REVISION(6, 10) void setDecimationTriangleCount(int newDecimationTriangleCount);
+    Q_REVISION(6, 10) float decimationTolerance() const;
+    Q_REVISION(6, 10) void setDecimationTolerance(float newDecimationTolerance);
+
+signals:
+    Q_REVISION(6, 10) void decimationTriangleCountChanged();
+    Q_REVISION(6, 10) void decimationToleranceChanged();
+
+protected:
+    QQuick3DPhysicsHullOptions hullOptions() const override;
+
+private:
+    int m_decimationTriangleCount = 0;
+    float m_decimationTolerance = 0.f;
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,124 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+// Tests that a body reusing the pooled actor of a destroyed body does not inherit the settings
+// of the destroyed body.
+
+import QtTest
+import QtQuick3D
+import QtQuick3D.Physics
+import QtQuick
+
+Item {
+    width: 640
+    height: 480
+    visible: true
+
+    PhysicsWorld {
+        id: world
+        running: true
+        forceDebugDraw: true
+        minimumTimestep: 15
+        maximumTimestep: 15
+        scene: viewport.scene
+        dynamicBodyPoolSize: 10
+    }
+
+    View3D {
+        id: viewport
+        anchors.fill: parent
+
+        environment: SceneEnvironment {
+            clearColor: "#d6dbdf"
+            backgroundMode: SceneEnvironment.Color
+        }
+
+        PerspectiveCamera {
+            position: Qt.vector3d(0, 200, 600)
+            eulerRotation: Qt.vector3d(-15, 0, 0)
+            clipFar: 5000
+            clipNear: 1
+        }
+
+        DirectionalLight {
+            eulerRotation.x: -45
+            eulerRotation.y: 45
+        }
+
+        StaticRigidBody {
+            position: Qt.vector3d(0, -50, 0)
+            collisionShapes: BoxShape {
+                scale: Qt.vector3d(10, 1, 10)
+            }
+            Model {
+                source: "#Cube"
+                scale: Qt.vector3d(10, 1, 10)
+                materials: DefaultMaterial {
+                    diffuseColor: "green"
+                }
+            }
+        }
+    }
+
+    // All bodies have the same collision shape, so each one can take the actor of the previous
+    Component {
+        id: boxComponent
+        DynamicRigidBody {
+            position: Qt.vector3d(0, 300, 0)
+            collisionShapes: BoxShape {}
+            Model {
+                source: "#Cube"
+                materials: PrincipledMaterial {
+                    baseColor: "yellow"
+                }
+            }
+        }
+    }
+
+    TestCase {
+        name: "ActorPool"
+        when: windowShown
+
+        function verifyFloating(body) {
+            // Give the body time to be added and to fall if it is affected by gravity
+            wait(500)
+            fuzzyCompare(body.position.y, 300, 1)
+        }
+
+        function verifyFalling(body) {
+            tryVerify(() => Math.abs(body.position.y - 50) < 1, 5000)
+        }
+
+        function replace(body, properties) {
+            body.destroy()
+            wait(50)
+            return boxComponent.createObject(viewport.scene, properties)
+        }
+
+        function test_gravity() {
+            let body = boxComponent.createObject(viewport.scene, { gravityEnabled: false })
+            verifyFloating(body)
+
+            body = replace(body, {})
+            verifyFalling(body)
+
+            body = replace(body, { gravityEnabled: false })
+            verifyFloating(body)
+
+            body = replace(body, {})
+            verifyFalling(body)
+            body.destroy()
+        }
+
+        function test_kinematic() {
+            let body = boxComponent.createObject(viewport.scene,
+                                                 { isKinematic: true,
+                                                   kinematicPosition: Qt.vector3d(0, 300, 0) })
+            verifyFloating(body)
+
+            body = replace(body, {})
+            verifyFalling(body)
+            body.destroy()
+        }
+    }
+}
@@ -0,0 +1,87 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+import QtQuick
+import QtTest
+import QtQuick3D
+import QtQuick3D.Physics
+
+Item {
+    width: 640
+    height: 480
+    visible: true
+
+    PhysicsWorld {
+        scene: viewport.scene
+        minimumTimestep: 15
+        maximumTimestep: 15
+        forceDebugDraw: true
+    }
+
+    View3D {
+        id: viewport
+        anchors.fill: parent
+
+        environment: SceneEnvironment {
+            clearColor: "#d6dbdf"
+            backgroundMode: SceneEnvironment.Color
+        }
+
+        PerspectiveCamera {
+            position: Qt.vector3d(-200, 100, 500)
+            eulerRotation: Qt.vector3d(-20, -20, 0)
+            clipFar: 5000
+            clipNear: 1
+        }
+
+        DirectionalLight {
+            eulerRotation.x: -45
+            eulerRotation.y: 45
+        }
+
+        DynamicRigidBody {
+            id: sphere
+            property bool hit: false
+            position: Qt.vector3d(0, 100, 0)
+            receiveContactReports: true
+            onBodyContact: (body, positions, impulses, normals) => hit = true
+            collisionShapes: ConvexMeshShape {
+                id: sphereShape
+                asynchronous: true
+                source: "#Sphere"
+            }
+            Model {
+                source: "#Sphere"
+                materials: PrincipledMaterial {
+                    baseColor: "yellow"
+                }
+            }
+        }
+
+        StaticRigidBody {
+            position: Qt.vector3d(0, -100, 0)
+            sendContactReports: true
+            collisionShapes: TriangleMeshShape {
+                id: groundShape
+                asynchronous: true
+                source: "#Cube"
+                scale: Qt.vector3d(10, 1, 10)
+            }
+            Model {
+                source: "#Cube"
+                scale: Qt.vector3d(10, 1, 10)
+                materials: DefaultMaterial {
+                    diffuseColor: "green"
+                }
+            }
+        }
+    }
+
+    TestCase {
+        name: "scene"
+        when: sphere.hit
+        function test_cooked() {
+            compare(sphereShape.status, MeshShape.Ready)
+            compare(groundShape.status, MeshShape.Ready)
+        }
+    }
+}
@@ -0,0 +1,108 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "collectionwriter.h"
+
+#include <QtQuick3DPhysics/private/qcollisionassets_p.h>
+#include <QtQuick3DPhysics/private/qphysicsworld_p.h>
+
+#include <QtCore/QFile>
+#include <QtCore/QScopeGuard>
+#include <QtCore/QUrl>
+
+#include "PxPhysicsAPI.h"
+#include "cooking/PxCooking.h"
+
+QString CollectionWriter::source() const
+{
+    return QUrl::fromLocalFile(m_dir.filePath(QStringLiteral("assets.cooked.col"))).toString();
+}
+
+bool CollectionWriter::write()
+{
+    physx::PxPhysics *physics = QPhysicsWorld::getPhysics();
+    physx::PxCooking *cooking = QPhysicsWorld::getCooking();
+    if (!physics || !cooking || !m_dir.isValid())
+        return false;
+    auto &insertionCallback = physics->getPhysicsInsertionCallback();
+
+    const physx::PxVec3 tetrahedron[] = {
+        { -100, 0, -100 }, { 100, 0, -100 }, { 0, 0, 100 }, { 0, 100, 0 }
+    };
+    physx::PxConvexMeshDesc convexDesc;
+    convexDesc.points.count = 4;
+    convexDesc.points.stride = sizeof(physx::PxVec3);
+    convexDesc.points.data = tetrahedron;
+    convexDesc.flags = physx::PxConvexFlag::eCOMPUTE_CONVEX;
+
+    // Both triangles face up
+    const physx::PxVec3 square[] = {
+        { -200, 0, -200 }, { 200, 0, -200 }, { 200, 0, 200 }, { -200, 0, 200 }
+    };
+    const physx::PxU32 triangles[] = { 0, 2, 1, 0, 3, 2 };
+    physx::PxTriangleMeshDesc triangleDesc;
+    triangleDesc.points.count = 4;
+    triangleDesc.points.stride = sizeof(physx::PxVec3);
+    triangleDesc.points.data = square;
+    triangleDesc.triangles.count = 2;
+    triangleDesc.triangles.stride = 3 * sizeof(physx::PxU32);
+    triangleDesc.triangles.data = triangles;
+
+    physx::PxHeightFieldSample samples[16];
+    for (auto &sample : samples)
+        sample = { 0, 0, 0 };
+    physx::PxHeightFieldDesc heightFieldDesc;
+    heightFieldDesc.format = physx::PxHeightFieldFormat::eS16_TM;
+    heightFieldDesc.nbColumns = 4;
+    heightFieldDesc.nbRows = 4;
+    heightFieldDesc.samples.data = samples;
+    heightFieldDesc.samples.stride = sizeof(physx::PxHeightFieldSample);
+
+    physx::PxBase *objects[] = {
+        cooking->createConvexMesh(convexDesc, insertionCallback),
+        cooking->createTriangleMesh(triangleDesc, insertionCallback),
+        cooking->createHeightField(heightFieldDesc, insertionCallback),
+    };
+    const QCollisionAssets::Kind kinds[] = { QCollisionAssets::Kind::ConvexMesh,
+                                             QCollisionAssets::Kind::TriangleMesh,
+                                             QCollisionAssets::Kind::HeightField };
+
+    physx::PxSerializationRegistry *registry =
+            physx::PxSerialization::createSerializationRegistry(*physics);
+    physx::PxCollection *collection = PxCreateCollection();
+    auto cleanup = qScopeGuard([&] {
+        collection->release();
+        for (auto *object : objects) {
+            if (object)
+                object->release();
+        }
+        registry->release();
+    });
+
+    for (quint32 i = 0; i < 3; ++i) {
+        if (!objects[i])
+            return false;
+        collection->add(*objects[i], QCollisionAssets::objectId(i + 1, kinds[i]));
+    }
+
+    physx::PxDefaultMemoryOutputStream buf;
+    if (!physx::PxSerialization::serializeCollectionToBinary(buf, *collection, *registry))
+        return false;
+
+    QCollisionAssets::Header header = {};
+    header.magic = QCollisionAssets::Magic;
+    header.version = QCollisionAssets::Version;
+    header.physxVersion = PX_PHYSICS_VERSION;
+    header.assetCount = 3;
+    header.dataOffset = QCollisionAssets::DataAlignment;
+    header.dataSize = buf.getSize();
+
+    QFile file(QUrl(source()).toLocalFile());
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    QByteArray headerData(QCollisionAssets::DataAlignment, '\0');
+    memcpy(headerData.data(), &header, sizeof(header));
+    file.write(headerData);
+    file.write(reinterpret_cast<const char *>(buf.getData()), buf.getSize());
+    return file.error() == QFileDevice::NoError;
+}
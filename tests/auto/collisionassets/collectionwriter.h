@@ -0,0 +1,31 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef COLLECTIONWRITER_H
+#define COLLECTIONWRITER_H
+
+#include <QtCore/QObject>
+#include <QtCore/QTemporaryDir>
+#include <QtQml/qqml.h>
+
+// Writes a collision asset collection like the cooker does. Asset 1 is a convex tetrahedron,
+// 200 wide and 100 high, asset 2 a 400 by 400 triangle mesh square and asset 3 a flat 4 by 4
+// height field. Everything lies on y = 0.
+class CollectionWriter : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QString source READ source CONSTANT FINAL)
+    QML_NAMED_ELEMENT(CollectionWriter)
+
+public:
+    // The URL of the collection, to which "#<asset>" is appended
+    QString source() const;
+
+    // Cooks the assets with the physics of the running world, returns false without one
+    Q_INVOKABLE bool write();
+
+private:
+    QTemporaryDir m_dir;
+};
+
+#endif
@@ -0,0 +1,151 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+// Tests reading a convex mesh, a triangle mesh and a height field from a collision asset
+// collection, and that a collection that could not be read is read once it exists.
+
+import QtTest
+import QtQuick3D
+import QtQuick3D.Physics
+import QtQuick
+import CollisionAssets
+
+Item {
+    width: 640
+    height: 480
+    visible: true
+
+    PhysicsWorld {
+        id: world
+        running: true
+        forceDebugDraw: true
+        minimumTimestep: 15
+        maximumTimestep: 15
+        scene: viewport.scene
+    }
+
+    CollectionWriter {
+        id: writer
+    }
+
+    View3D {
+        id: viewport
+        anchors.fill: parent
+
+        environment: SceneEnvironment {
+            clearColor: "#d6dbdf"
+            backgroundMode: SceneEnvironment.Color
+        }
+
+        PerspectiveCamera {
+            position: Qt.vector3d(0, 400, 1200)
+            eulerRotation: Qt.vector3d(-15, 0, 0)
+            clipFar: 5000
+            clipNear: 1
+        }
+
+        DirectionalLight {
+            eulerRotation.x: -45
+            eulerRotation.y: 45
+        }
+    }
+
+    Component {
+        id: convexComponent
+        StaticRigidBody {
+            property alias shape: convexShape
+            sendContactReports: true
+            collisionShapes: ConvexMeshShape {
+                id: convexShape
+                source: writer.source + "#1"
+            }
+        }
+    }
+
+    Component {
+        id: triangleComponent
+        StaticRigidBody {
+            property alias shape: triangleShape
+            sendContactReports: true
+            collisionShapes: TriangleMeshShape {
+                id: triangleShape
+                source: writer.source + "#2"
+            }
+        }
+    }
+
+    Component {
+        id: heightFieldComponent
+        StaticRigidBody {
+            sendContactReports: true
+            collisionShapes: HeightFieldShape {
+                source: writer.source + "#3"
+                extents: Qt.vector3d(400, 100, 400)
+            }
+        }
+    }
+
+    Component {
+        id: ballComponent
+        DynamicRigidBody {
+            property bool collided: false
+            receiveContactReports: true
+            collisionShapes: SphereShape {}
+            onBodyContact: collided = true
+            Model {
+                source: "#Sphere"
+                materials: PrincipledMaterial {
+                    baseColor: "yellow"
+                }
+            }
+        }
+    }
+
+    TestCase {
+        name: "CollisionAssets"
+        when: windowShown
+
+        function test_1_missing_collection() {
+            // Reading the collection before it is written fails
+            let body = convexComponent.createObject(viewport.scene)
+            tryVerify(() => body.shape.status === ConvexMeshShape.Error, 5000)
+            body.destroy()
+            wait(50)
+        }
+
+        function test_2_assets() {
+            verify(writer.write())
+
+            let convex = convexComponent.createObject(viewport.scene,
+                                                      { position: Qt.vector3d(-500, 0, 0) })
+            let triangle = triangleComponent.createObject(viewport.scene,
+                                                          { position: Qt.vector3d(0, 0, 0) })
+            let heightField = heightFieldComponent.createObject(
+                    viewport.scene, { position: Qt.vector3d(500, 0, 0) })
+
+            let convexBall = ballComponent.createObject(viewport.scene,
+                                                        { position: Qt.vector3d(-500, 300, 0) })
+            let triangleBall = ballComponent.createObject(viewport.scene,
+                                                          { position: Qt.vector3d(0, 300, 0) })
+            let heightFieldBall = ballComponent.createObject(viewport.scene,
+                                                             { position: Qt.vector3d(500, 300, 0) })
+
+            tryVerify(() => convex.shape.status === ConvexMeshShape.Ready, 5000)
+            tryVerify(() => triangle.shape.status === TriangleMeshShape.Ready, 5000)
+
+            tryVerify(() => convexBall.collided, 5000)
+            tryVerify(() => triangleBall.collided, 5000)
+            tryVerify(() => heightFieldBall.collided, 5000)
+
+            // The triangle mesh and the height field are flat at y = 0
+            tryVerify(() => triangleBall.isSleeping, 10000)
+            fuzzyCompare(triangleBall.position.y, 50, 1)
+            tryVerify(() => heightFieldBall.isSleeping, 10000)
+            fuzzyCompare(heightFieldBall.position.y, 50, 1)
+
+            for (let body of [convexBall, triangleBall, heightFieldBall, convex, triangle,
+                              heightField])
+                body.destroy()
+        }
+    }
+}
@@ -0,0 +1,59 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "ignorecontactsmodifier.h"
+
+#include "PxContactModifyCallback.h"
+
+IgnoreContactsModifier::~IgnoreContactsModifier()
+{
+    unregisterModifier();
+}
+
+QPhysicsWorld *IgnoreContactsModifier::world() const
+{
+    return m_world;
+}
+
+void IgnoreContactsModifier::setWorld(QPhysicsWorld *world)
+{
+    unregisterModifier();
+    m_world = world;
+    registerModifier();
+}
+
+int IgnoreContactsModifier::filterGroup() const
+{
+    return m_filterGroup;
+}
+
+void IgnoreContactsModifier::setFilterGroup(int filterGroup)
+{
+    unregisterModifier();
+    m_filterGroup = filterGroup;
+    registerModifier();
+}
+
+int IgnoreContactsModifier::modifiedPairs() const
+{
+    return m_modifiedPairs.loadAcquire();
+}
+
+void IgnoreContactsModifier::modifyContacts(physx::PxContactModifyPair &pair, int /*shapeIndex*/)
+{
+    for (physx::PxU32 i = 0; i < pair.contacts.size(); i++)
+        pair.contacts.ignore(i);
+    m_modifiedPairs.fetchAndAddRelease(1);
+}
+
+void IgnoreContactsModifier::unregisterModifier()
+{
+    if (m_world && m_filterGroup >= 0 && m_world->contactModifier(m_filterGroup) == this)
+        m_world->setContactModifier(m_filterGroup, nullptr);
+}
+
+void IgnoreContactsModifier::registerModifier()
+{
+    if (m_world && m_filterGroup >= 0)
+        m_world->setContactModifier(m_filterGroup, this);
+}
@@ -0,0 +1,46 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef IGNORECONTACTSMODIFIER_H
+#define IGNORECONTACTSMODIFIER_H
+
+#include <QtQuick3DPhysics/private/qphysicscontactmodifier_p.h>
+#include <QtQuick3DPhysics/private/qphysicsworld_p.h>
+
+#include <QtCore/QAtomicInt>
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtQml/qqml.h>
+
+// Ignores all contacts of the shapes in filterGroup, so they fall through everything. A negative
+// filterGroup unregisters the modifier.
+class IgnoreContactsModifier : public QObject, public QPhysicsContactModifier
+{
+    Q_OBJECT
+    Q_PROPERTY(QPhysicsWorld *world READ world WRITE setWorld FINAL)
+    Q_PROPERTY(int filterGroup READ filterGroup WRITE setFilterGroup FINAL)
+    QML_NAMED_ELEMENT(IgnoreContactsModifier)
+
+public:
+    ~IgnoreContactsModifier() override;
+
+    QPhysicsWorld *world() const;
+    void setWorld(QPhysicsWorld *world);
+    int filterGroup() const;
+    void setFilterGroup(int filterGroup);
+
+    // Number of contact pairs passed to the modifier so far
+    Q_INVOKABLE int modifiedPairs() const;
+
+    void modifyContacts(physx::PxContactModifyPair &pair, int shapeIndex) override;
+
+private:
+    void unregisterModifier();
+    void registerModifier();
+
+    QPointer<QPhysicsWorld> m_world;
+    int m_filterGroup = -1;
+    QAtomicInt m_modifiedPairs = 0;
+};
+
+#endif
@@ -0,0 +1,117 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+import QtTest
+import QtQuick3D
+import QtQuick3D.Physics
+import QtQuick
+import ContactModifier
+
+Item {
+    width: 640
+    height: 480
+    visible: true
+
+    PhysicsWorld {
+        id: world
+        running: true
+        forceDebugDraw: true
+        minimumTimestep: 15
+        maximumTimestep: 15
+        scene: viewport.scene
+    }
+
+    IgnoreContactsModifier {
+        id: modifier
+        world: world
+        filterGroup: 2
+    }
+
+    View3D {
+        id: viewport
+        anchors.fill: parent
+
+        environment: SceneEnvironment {
+            clearColor: "#d6dbdf"
+            backgroundMode: SceneEnvironment.Color
+        }
+
+        PerspectiveCamera {
+            position: Qt.vector3d(0, 200, 600)
+            eulerRotation: Qt.vector3d(-15, 0, 0)
+            clipFar: 5000
+            clipNear: 1
+        }
+
+        DirectionalLight {
+            eulerRotation.x: -45
+            eulerRotation.y: 45
+        }
+
+        StaticRigidBody {
+            position: Qt.vector3d(0, -50, 0)
+            collisionShapes: BoxShape {
+                scale: Qt.vector3d(10, 1, 10)
+            }
+            Model {
+                source: "#Cube"
+                scale: Qt.vector3d(10, 1, 10)
+                materials: DefaultMaterial {
+                    diffuseColor: "green"
+                }
+            }
+        }
+
+        DynamicRigidBody {
+            id: modifiedBox
+            position: Qt.vector3d(-150, 100, 0)
+            filterGroup: 2
+            collisionShapes: BoxShape {}
+            Model {
+                source: "#Cube"
+                materials: PrincipledMaterial {
+                    baseColor: "red"
+                }
+            }
+        }
+
+        DynamicRigidBody {
+            id: plainBox
+            position: Qt.vector3d(150, 100, 0)
+            collisionShapes: BoxShape {}
+            Model {
+                source: "#Cube"
+                materials: PrincipledMaterial {
+                    baseColor: "yellow"
+                }
+            }
+        }
+    }
+
+    TestCase {
+        name: "ContactModifier"
+        when: windowShown
+
+        function test_1_modified_group() {
+            // Only the pairs of the registered group are modified
+            tryVerify(() => modifiedBox.position.y < -200, 10000)
+            verify(modifier.modifiedPairs() > 0)
+            tryVerify(() => plainBox.isSleeping, 10000)
+            fuzzyCompare(plainBox.position.y, 50, 1)
+        }
+
+        function test_2_change_group() {
+            // Registering for another group refilters the pairs that already touch
+            modifier.filterGroup = 0
+            // Wake the body up in case refiltering does not
+            plainBox.applyCentralImpulse(Qt.vector3d(0, 100, 0))
+            tryVerify(() => plainBox.position.y < -200, 10000)
+        }
+
+        function cleanupTestCase() {
+            // The modifier has to be unregistered before it is destroyed
+            modifier.filterGroup = -1
+            wait(100)
+        }
+    }
+}
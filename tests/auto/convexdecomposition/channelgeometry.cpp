@@ -0,0 +1,52 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "channelgeometry.h"
+#include <QtGui/QVector2D>
+#include <QtGui/QVector3D>
+#include <array>
+
+ChannelGeometry::ChannelGeometry()
+{
+    // Counter-clockwise profile in the xy plane
+    constexpr std::array<QVector2D, 8> profile = {
+        QVector2D(-150.0f, 0.0f),  QVector2D(150.0f, 0.0f),   QVector2D(150.0f, 150.0f),
+        QVector2D(100.0f, 150.0f), QVector2D(100.0f, 50.0f),  QVector2D(-100.0f, 50.0f),
+        QVector2D(-100.0f, 150.0f), QVector2D(-150.0f, 150.0f)
+    };
+    constexpr int kCount = int(profile.size());
+    constexpr float kDepth = 150.0f;
+
+    // Front vertices first, then the back vertices
+    QByteArray vertexData(2 * kCount * sizeof(QVector3D), Qt::Initialization::Uninitialized);
+    QVector3D *p = reinterpret_cast<QVector3D *>(vertexData.data());
+    for (float z : { kDepth, -kDepth }) {
+        for (const QVector2D &point : profile)
+            *p++ = QVector3D(point.x(), point.y(), z);
+    }
+
+    // Triangulation of the profile
+    constexpr std::array<quint32, 18> cap = { 0, 1, 4, 0, 4, 5, 1, 2, 3,
+                                              1, 3, 4, 0, 5, 6, 0, 6, 7 };
+    QList<quint32> indices;
+    for (int i = 0; i < int(cap.size()); i += 3) {
+        indices << cap[i] << cap[i + 1] << cap[i + 2];
+        indices << cap[i] + kCount << cap[i + 2] + kCount << cap[i + 1] + kCount;
+    }
+    for (quint32 i = 0; i < kCount; ++i) {
+        const quint32 next = (i + 1) % kCount;
+        indices << i << i + kCount << next + kCount;
+        indices << i << next + kCount << next;
+    }
+
+    setVertexData(vertexData);
+    setIndexData(QByteArray(reinterpret_cast<const char *>(indices.constData()),
+                            indices.size() * sizeof(quint32)));
+    setStride(sizeof(QVector3D));
+    setBounds(QVector3D(-150.0f, 0.0f, -kDepth), QVector3D(150.0f, 150.0f, kDepth));
+    setPrimitiveType(QQuick3DGeometry::PrimitiveType::Triangles);
+    addAttribute(QQuick3DGeometry::Attribute::PositionSemantic, 0,
+                 QQuick3DGeometry::Attribute::F32Type);
+    addAttribute(QQuick3DGeometry::Attribute::IndexSemantic, 0,
+                 QQuick3DGeometry::Attribute::U32Type);
+}
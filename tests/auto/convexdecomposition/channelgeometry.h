@@ -0,0 +1,20 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef CHANNELGEOMETRY_H
+#define CHANNELGEOMETRY_H
+
+#include <QtQuick3D/QQuick3DGeometry>
+
+// A closed U-shaped prism, 300 wide and 150 high with a 200 wide and 100 deep channel
+// running along the z axis. The bottom of the prism is at y = 0.
+class ChannelGeometry : public QQuick3DGeometry
+{
+    Q_OBJECT
+    QML_NAMED_ELEMENT(ChannelGeometry)
+
+public:
+    ChannelGeometry();
+};
+
+#endif
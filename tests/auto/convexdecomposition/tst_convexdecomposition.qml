@@ -0,0 +1,100 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+import QtQuick
+import QtTest
+import QtQuick3D
+import QtQuick3D.Physics
+import ConvexDecomposition
+
+Item {
+    width: 640
+    height: 480
+    visible: true
+
+    PhysicsWorld {
+        scene: viewport.scene
+        minimumTimestep: 15
+        maximumTimestep: 15
+        forceDebugDraw: true
+    }
+
+    View3D {
+        id: viewport
+        anchors.fill: parent
+
+        environment: SceneEnvironment {
+            clearColor: "#d6dbdf"
+            backgroundMode: SceneEnvironment.Color
+        }
+
+        PerspectiveCamera {
+            position: Qt.vector3d(-200, 300, 600)
+            eulerRotation: Qt.vector3d(-20, -20, 0)
+            clipFar: 5000
+            clipNear: 1
+        }
+
+        DirectionalLight {
+            eulerRotation.x: -45
+            eulerRotation.y: 45
+        }
+
+        // The sphere falls into the channel and comes to rest on its floor at y = 50, so its
+        // center ends up at y = 100. With a single convex hull it would rest on top of the walls
+        // at y = 150 with its center at y = 200.
+        DynamicRigidBody {
+            id: sphere
+            property bool hit: false
+            position: Qt.vector3d(0, 400, 0)
+            receiveContactReports: true
+            onBodyContact: (body, positions, impulses, normals) => hit = true
+            collisionShapes: SphereShape {}
+            Model {
+                source: "#Sphere"
+                materials: PrincipledMaterial {
+                    baseColor: "yellow"
+                }
+            }
+        }
+
+        DynamicRigidBody {
+            id: channel
+            sendContactReports: true
+            collisionShapes: ConvexDecompositionShape {
+                id: channelShape
+                asynchronous: true
+                geometry: ChannelGeometry {}
+            }
+            Model {
+                geometry: ChannelGeometry {}
+                materials: PrincipledMaterial {
+                    baseColor: "red"
+                }
+            }
+        }
+
+        StaticRigidBody {
+            position: Qt.vector3d(0, -50, 0)
+            collisionShapes: BoxShape {
+                scale: Qt.vector3d(10, 1, 10)
+            }
+            Model {
+                source: "#Cube"
+                scale: Qt.vector3d(10, 1, 10)
+                materials: DefaultMaterial {
+                    diffuseColor: "green"
+                }
+            }
+        }
+    }
+
+    TestCase {
+        name: "scene"
+        when: sphere.hit
+        function test_decomposition() {
+            compare(channelShape.status, MeshShape.Ready)
+            tryVerify(() => Math.abs(sphere.position.y - 100) < 10, 10000)
+            verify(Math.abs(channel.position.y) < 10)
+        }
+    }
+}
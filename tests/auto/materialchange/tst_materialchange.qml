@@ -0,0 +1,163 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+// Tests that assigning another physicsMaterial to a body at runtime changes its friction and
+// restitution.
+
+import QtTest
+import QtQuick3D
+import QtQuick3D.Physics
+import QtQuick
+
+Item {
+    width: 640
+    height: 480
+    visible: true
+
+    PhysicsWorld {
+        id: world
+        running: true
+        forceDebugDraw: true
+        minimumTimestep: 15
+        maximumTimestep: 15
+        scene: viewport.scene
+    }
+
+    PhysicsMaterial {
+        id: roughMaterial
+        staticFriction: 0.5
+        dynamicFriction: 0.5
+        restitution: 0
+    }
+
+    PhysicsMaterial {
+        id: slipperyMaterial
+        staticFriction: 0
+        dynamicFriction: 0
+        restitution: 0
+    }
+
+    PhysicsMaterial {
+        id: bouncyMaterial
+        staticFriction: 0.5
+        dynamicFriction: 0.5
+        restitution: 1
+    }
+
+    View3D {
+        id: viewport
+        anchors.fill: parent
+
+        environment: SceneEnvironment {
+            clearColor: "#d6dbdf"
+            backgroundMode: SceneEnvironment.Color
+        }
+
+        PerspectiveCamera {
+            position: Qt.vector3d(0, 400, 1200)
+            eulerRotation: Qt.vector3d(-15, 0, 0)
+            clipFar: 5000
+            clipNear: 1
+        }
+
+        DirectionalLight {
+            eulerRotation.x: -45
+            eulerRotation.y: 45
+        }
+
+        StaticRigidBody {
+            id: slideFloor
+            position: Qt.vector3d(0, -50, -300)
+            physicsMaterial: roughMaterial
+            collisionShapes: BoxShape {
+                scale: Qt.vector3d(20, 1, 5)
+            }
+            Model {
+                source: "#Cube"
+                scale: Qt.vector3d(20, 1, 5)
+                materials: DefaultMaterial {
+                    diffuseColor: "green"
+                }
+            }
+        }
+
+        StaticRigidBody {
+            id: bounceFloor
+            position: Qt.vector3d(0, -50, 300)
+            physicsMaterial: roughMaterial
+            collisionShapes: BoxShape {
+                scale: Qt.vector3d(20, 1, 5)
+            }
+            Model {
+                source: "#Cube"
+                scale: Qt.vector3d(20, 1, 5)
+                materials: DefaultMaterial {
+                    diffuseColor: "blue"
+                }
+            }
+        }
+
+        DynamicRigidBody {
+            id: box
+            position: Qt.vector3d(-800, 50, -300)
+            physicsMaterial: roughMaterial
+            collisionShapes: BoxShape {}
+            Model {
+                source: "#Cube"
+                materials: PrincipledMaterial {
+                    baseColor: "yellow"
+                }
+            }
+        }
+
+        DynamicRigidBody {
+            id: ball
+            position: Qt.vector3d(0, 50, 300)
+            physicsMaterial: roughMaterial
+            collisionShapes: SphereShape {}
+            Model {
+                source: "#Sphere"
+                materials: PrincipledMaterial {
+                    baseColor: "red"
+                }
+            }
+        }
+    }
+
+    TestCase {
+        name: "MaterialChange"
+        when: windowShown
+
+        function slideDistance() {
+            const startX = box.position.x
+            box.setLinearVelocity(Qt.vector3d(300, 0, 0))
+            wait(1000)
+            return box.position.x - startX
+        }
+
+        function test_friction() {
+            // Let the box settle on the floor
+            wait(500)
+            verify(slideDistance() < 150)
+
+            // Friction is combined from both bodies, so both get the slippery material
+            slideFloor.physicsMaterial = slipperyMaterial
+            box.physicsMaterial = slipperyMaterial
+            wait(100)
+            verify(slideDistance() > 250)
+        }
+
+        function test_restitution() {
+            ball.reset(Qt.vector3d(0, 300, 300), Qt.vector3d(0, 0, 0))
+            tryVerify(() => ball.position.y < 60, 5000)
+            wait(1000)
+            fuzzyCompare(ball.position.y, 50, 1)
+
+            bounceFloor.physicsMaterial = bouncyMaterial
+            ball.physicsMaterial = bouncyMaterial
+            ball.reset(Qt.vector3d(0, 300, 300), Qt.vector3d(0, 0, 0))
+            tryVerify(() => ball.position.y < 60, 5000)
+            tryVerify(() => ball.position.y > 200, 5000)
+        }
+    }
+}
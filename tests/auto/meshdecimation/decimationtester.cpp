@@ -0,0 +1,55 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "decimationtester.h"
+#include "gridgeometry.h"
+
+#include <QtQuick3DPhysics/private/qmeshdecimation_p.h>
+
+#include <cmath>
+#include <limits>
+
+QVariantMap DecimationTester::simplify(int cells, float bumpHeight, float roughness,
+                                       int targetTriangles, float tolerance) const
+{
+    QList<QVector3D> vertices;
+    QList<quint32> indices;
+    GridGeometry::build(cells, bumpHeight, roughness, vertices, indices);
+    const qsizetype inputTriangles = indices.size() / 3;
+
+    QMeshDecimation::simplify(vertices, indices, targetTriangles, tolerance);
+
+    // Twice the area of a triangle projected onto the xz plane is the y component of its normal
+    double area = 0;
+    int downward = 0;
+    for (qsizetype i = 0; i + 2 < indices.size(); i += 3) {
+        const QVector3D &p0 = vertices[indices[i]];
+        const QVector3D &p1 = vertices[indices[i + 1]];
+        const QVector3D &p2 = vertices[indices[i + 2]];
+        const QVector3D normal = QVector3D::crossProduct(p1 - p0, p2 - p0);
+        if (normal.y() <= 0)
+            downward++;
+        area += normal.y() / 2.0;
+    }
+
+    constexpr float kEpsilon = 0.01f;
+    int corners = 0;
+    int outside = 0;
+    float maximumHeight = -std::numeric_limits<float>::max();
+    for (const QVector3D &vertex : std::as_const(vertices)) {
+        if (std::abs(std::abs(vertex.x()) - 200.0f) < kEpsilon
+            && std::abs(std::abs(vertex.z()) - 200.0f) < kEpsilon)
+            corners++;
+        if (std::abs(vertex.x()) > 200.0f + kEpsilon || std::abs(vertex.z()) > 200.0f + kEpsilon)
+            outside++;
+        maximumHeight = qMax(maximumHeight, vertex.y());
+    }
+
+    return { { QStringLiteral("inputTriangles"), int(inputTriangles) },
+             { QStringLiteral("triangles"), int(indices.size() / 3) },
+             { QStringLiteral("area"), area },
+             { QStringLiteral("downward"), downward },
+             { QStringLiteral("corners"), corners },
+             { QStringLiteral("outside"), outside },
+             { QStringLiteral("maximumHeight"), maximumHeight } };
+}
@@ -0,0 +1,25 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef DECIMATIONTESTER_H
+#define DECIMATIONTESTER_H
+
+#include <QtCore/QObject>
+#include <QtCore/QVariantMap>
+#include <QtQml/qqml.h>
+
+// Simplifies grids of GridGeometry and measures the result
+class DecimationTester : public QObject
+{
+    Q_OBJECT
+    QML_NAMED_ELEMENT(DecimationTester)
+
+public:
+    // Returns the number of triangles before and after, the area of the result seen from above,
+    // the number of triangles that do not face up, the number of grid corners that are kept, the
+    // number of vertices outside the grid and the height of the highest vertex
+    Q_INVOKABLE QVariantMap simplify(int cells, float bumpHeight, float roughness,
+                                     int targetTriangles, float tolerance) const;
+};
+
+#endif
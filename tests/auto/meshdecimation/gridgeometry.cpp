@@ -0,0 +1,75 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "gridgeometry.h"
+
+GridGeometry::GridGeometry()
+{
+    updateData();
+}
+
+float GridGeometry::bumpHeight() const
+{
+    return m_bumpHeight;
+}
+
+void GridGeometry::setBumpHeight(float bumpHeight)
+{
+    if (qFuzzyCompare(m_bumpHeight, bumpHeight))
+        return;
+    m_bumpHeight = bumpHeight;
+    updateData();
+    update();
+    emit bumpHeightChanged();
+}
+
+void GridGeometry::build(int cells, float bumpHeight, float roughness, QList<QVector3D> &vertices,
+                         QList<quint32> &indices)
+{
+    constexpr float kSize = 400.0f;
+    const float step = kSize / cells;
+
+    // Linear congruential generator, so that every platform gets the same heights
+    quint32 state = 12;
+    vertices.clear();
+    for (int i = 0; i <= cells; ++i) {
+        for (int j = 0; j <= cells; ++j) {
+            state = state * 1664525u + 1013904223u;
+            float height = roughness * float(state >> 8) / float(1 << 24);
+            if (i == cells / 2 && j == cells / 2)
+                height += bumpHeight;
+            vertices.append(QVector3D(-kSize / 2 + i * step, height, -kSize / 2 + j * step));
+        }
+    }
+
+    // Counter-clockwise seen from above
+    indices.clear();
+    for (int i = 0; i < cells; ++i) {
+        for (int j = 0; j < cells; ++j) {
+            const quint32 a = i * (cells + 1) + j;
+            const quint32 b = a + cells + 1;
+            indices << a << a + 1 << b << b << a + 1 << b + 1;
+        }
+    }
+}
+
+void GridGeometry::updateData()
+{
+    clear();
+
+    QList<QVector3D> vertices;
+    QList<quint32> indices;
+    build(10, m_bumpHeight, 0.f, vertices, indices);
+
+    setVertexData(QByteArray(reinterpret_cast<const char *>(vertices.constData()),
+                             vertices.size() * sizeof(QVector3D)));
+    setIndexData(QByteArray(reinterpret_cast<const char *>(indices.constData()),
+                            indices.size() * sizeof(quint32)));
+    setStride(sizeof(QVector3D));
+    setBounds(QVector3D(-200.0f, 0.0f, -200.0f), QVector3D(200.0f, m_bumpHeight, 200.0f));
+    setPrimitiveType(QQuick3DGeometry::PrimitiveType::Triangles);
+    addAttribute(QQuick3DGeometry::Attribute::PositionSemantic, 0,
+                 QQuick3DGeometry::Attribute::F32Type);
+    addAttribute(QQuick3DGeometry::Attribute::IndexSemantic, 0,
+                 QQuick3DGeometry::Attribute::U32Type);
+}
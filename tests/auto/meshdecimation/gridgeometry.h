@@ -0,0 +1,37 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef GRIDGEOMETRY_H
+#define GRIDGEOMETRY_H
+
+#include <QtQuick3D/QQuick3DGeometry>
+#include <QtCore/QList>
+#include <QtGui/QVector3D>
+
+// An open square grid in the xz plane, 400 wide and facing up. The center vertex is raised by
+// bumpHeight and every vertex by a pseudo-random amount between 0 and roughness.
+class GridGeometry : public QQuick3DGeometry
+{
+    Q_OBJECT
+    Q_PROPERTY(float bumpHeight READ bumpHeight WRITE setBumpHeight NOTIFY bumpHeightChanged)
+    QML_NAMED_ELEMENT(GridGeometry)
+
+public:
+    GridGeometry();
+
+    float bumpHeight() const;
+    void setBumpHeight(float bumpHeight);
+
+    static void build(int cells, float bumpHeight, float roughness, QList<QVector3D> &vertices,
+                      QList<quint32> &indices);
+
+signals:
+    void bumpHeightChanged();
+
+private:
+    void updateData();
+
+    float m_bumpHeight = 0.f;
+};
+
+#endif
@@ -0,0 +1,135 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+import QtQuick
+import QtTest
+import QtQuick3D
+import QtQuick3D.Physics
+import MeshDecimation
+
+Item {
+    width: 640
+    height: 480
+    visible: true
+
+    PhysicsWorld {
+        scene: viewport.scene
+        minimumTimestep: 15
+        maximumTimestep: 15
+        forceDebugDraw: true
+    }
+
+    DecimationTester {
+        id: tester
+    }
+
+    View3D {
+        id: viewport
+        anchors.fill: parent
+
+        environment: SceneEnvironment {
+            clearColor: "#d6dbdf"
+            backgroundMode: SceneEnvironment.Color
+        }
+
+        PerspectiveCamera {
+            position: Qt.vector3d(0, 300, 600)
+            eulerRotation: Qt.vector3d(-25, 0, 0)
+            clipFar: 5000
+            clipNear: 1
+        }
+
+        DirectionalLight {
+            eulerRotation.x: -45
+            eulerRotation.y: 45
+        }
+
+        // The 200 triangles of the grid are reduced to 20. The bump in the middle is kept and
+        // the rest of the grid stays flat, so the sphere comes to rest with its center at y = 50.
+        StaticRigidBody {
+            sendContactReports: true
+            collisionShapes: TriangleMeshShape {
+                id: decimatedShape
+                geometry: GridGeometry {
+                    bumpHeight: 50
+                }
+                decimationTriangleCount: 20
+            }
+        }
+
+        DynamicRigidBody {
+            id: sphere
+            property bool hit: false
+            position: Qt.vector3d(150, 300, 150)
+            receiveContactReports: true
+            onBodyContact: (body, positions, impulses, normals) => hit = true
+            collisionShapes: SphereShape {}
+            Model {
+                source: "#Sphere"
+                materials: PrincipledMaterial {
+                    baseColor: "yellow"
+                }
+            }
+        }
+    }
+
+    TestCase {
+        name: "MeshDecimation"
+        when: windowShown
+
+        function verifyBoundary(result) {
+            // The outline of the grid is kept, so the area seen from above does not change
+            compare(result.corners, 4)
+            compare(result.outside, 0)
+            fuzzyCompare(result.area, 400 * 400, 1)
+        }
+
+        function test_triangle_count() {
+            let result = tester.simplify(10, 50, 0, 20, 0)
+            compare(result.inputTriangles, 200)
+            verify(result.triangles <= 20)
+            verify(result.triangles > 10)
+            compare(result.maximumHeight, 50)
+            verifyBoundary(result)
+
+            result = tester.simplify(10, 50, 0, 4, 0)
+            verify(result.triangles <= 4)
+            verify(result.triangles > 0)
+        }
+
+        function test_tolerance() {
+            // A flat grid collapses completely without moving the surface
+            let result = tester.simplify(10, 0, 0, 0, 1)
+            compare(result.triangles, 2)
+            compare(result.maximumHeight, 0)
+            verifyBoundary(result)
+
+            // Flattening the bump would move the surface much further than the tolerance
+            result = tester.simplify(10, 50, 0, 0, 1)
+            verify(result.triangles < result.inputTriangles)
+            compare(result.maximumHeight, 50)
+            verifyBoundary(result)
+
+            const loose = tester.simplify(10, 50, 0, 0, 100)
+            verify(loose.triangles < result.triangles)
+            verify(loose.maximumHeight < 50)
+        }
+
+        function test_no_flipped_triangles() {
+            // Every triangle of the rough grid faces up, and the simplified grid should as well
+            for (let target = 8; target <= 120; target += 8) {
+                const result = tester.simplify(16, 0, 8, target, 0)
+                verify(result.triangles <= target)
+                compare(result.downward, 0, "target " + target)
+            }
+        }
+
+        function test_collision() {
+            tryVerify(() => sphere.hit, 5000)
+            compare(decimatedShape.status, TriangleMeshShape.Ready)
+            tryVerify(() => sphere.isSleeping, 10000)
+            fuzzyCompare(sphere.position.y, 50, 1)
+            fuzzyCompare(sphere.position.x, 150, 1)
+            fuzzyCompare(sphere.position.z, 150, 1)
+        }
+    }
+}
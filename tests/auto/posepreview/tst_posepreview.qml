@@ -0,0 +1,110 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+import QtTest
+import QtQuick3D
+import QtQuick3D.Physics
+import QtQuick
+
+Item {
+    width: 640
+    height: 480
+    visible: true
+
+    PhysicsWorld {
+        id: world
+        running: true
+        forceDebugDraw: true
+        minimumTimestep: 15
+        maximumTimestep: 15
+        scene: viewport.scene
+    }
+
+    View3D {
+        id: viewport
+        anchors.fill: parent
+
+        environment: SceneEnvironment {
+            clearColor: "#d6dbdf"
+            backgroundMode: SceneEnvironment.Color
+        }
+
+        PerspectiveCamera {
+            position: Qt.vector3d(0, 200, 600)
+            eulerRotation: Qt.vector3d(-15, 0, 0)
+            clipFar: 5000
+            clipNear: 1
+        }
+
+        DirectionalLight {
+            eulerRotation.x: -45
+            eulerRotation.y: 45
+        }
+
+        StaticRigidBody {
+            position: Qt.vector3d(0, -50, 0)
+            collisionShapes: BoxShape {
+                scale: Qt.vector3d(10, 1, 10)
+            }
+            Model {
+                source: "#Cube"
+                scale: Qt.vector3d(10, 1, 10)
+                materials: DefaultMaterial {
+                    diffuseColor: "green"
+                }
+            }
+        }
+
+        DynamicRigidBody {
+            id: previewBox
+            property int positionUpdates: 0
+            position: Qt.vector3d(-150, 300, 0)
+            enablePoseIntegrationPreview: true
+            onPositionChanged: positionUpdates++
+            collisionShapes: BoxShape {}
+            Model {
+                source: "#Cube"
+                materials: PrincipledMaterial {
+                    baseColor: "yellow"
+                }
+            }
+        }
+
+        DynamicRigidBody {
+            id: referenceBox
+            position: Qt.vector3d(150, 300, 0)
+            collisionShapes: BoxShape {}
+            Model {
+                source: "#Cube"
+                materials: PrincipledMaterial {
+                    baseColor: "red"
+                }
+            }
+        }
+    }
+
+    TestCase {
+        name: "PosePreview"
+        when: windowShown
+
+        function test_preview() {
+            // The previewed pose moves the body while it falls, and it ends up where the
+            // simulation puts a body without previews
+            tryVerify(() => previewBox.position.y < 250, 5000)
+            verify(previewBox.positionUpdates > 0)
+            tryVerify(() => previewBox.isSleeping && referenceBox.isSleeping, 10000)
+            fuzzyCompare(previewBox.position.y, referenceBox.position.y, 0.5)
+            fuzzyCompare(previewBox.position.y, 50, 1)
+            fuzzyCompare(previewBox.position.x, -150, 1)
+        }
+
+        function test_toggle() {
+            // Turning the preview off keeps the body simulated normally
+            previewBox.enablePoseIntegrationPreview = false
+            previewBox.applyCentralImpulse(Qt.vector3d(0, 500, 0))
+            tryVerify(() => previewBox.position.y > 60, 2000)
+            tryVerify(() => previewBox.isSleeping, 10000)
+            fuzzyCompare(previewBox.position.y, 50, 1)
+        }
+    }
+}
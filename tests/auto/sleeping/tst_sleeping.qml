@@ -0,0 +1,100 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+import QtTest
+import QtQuick3D
+import QtQuick3D.Physics
+import QtQuick
+
+Item {
+    width: 640
+    height: 480
+    visible: true
+
+    PhysicsWorld {
+        id: world
+        running: true
+        forceDebugDraw: true
+        minimumTimestep: 15
+        maximumTimestep: 15
+        scene: viewport.scene
+    }
+
+    View3D {
+        id: viewport
+        anchors.fill: parent
+
+        environment: SceneEnvironment {
+            clearColor: "#d6dbdf"
+            backgroundMode: SceneEnvironment.Color
+        }
+
+        PerspectiveCamera {
+            position: Qt.vector3d(0, 200, 600)
+            eulerRotation: Qt.vector3d(-15, 0, 0)
+            clipFar: 5000
+            clipNear: 1
+        }
+
+        DirectionalLight {
+            eulerRotation.x: -45
+            eulerRotation.y: 45
+        }
+
+        StaticRigidBody {
+            position: Qt.vector3d(0, -50, 0)
+            collisionShapes: BoxShape {
+                scale: Qt.vector3d(10, 1, 10)
+            }
+            Model {
+                source: "#Cube"
+                scale: Qt.vector3d(10, 1, 10)
+                materials: DefaultMaterial {
+                    diffuseColor: "green"
+                }
+            }
+        }
+
+        // Starts awake, so the first notification it gets is onSleep
+        DynamicRigidBody {
+            id: box
+            position: Qt.vector3d(0, 100, 0)
+            collisionShapes: BoxShape {}
+            Model {
+                source: "#Cube"
+                materials: PrincipledMaterial {
+                    baseColor: "yellow"
+                }
+            }
+        }
+    }
+
+    SignalSpy {
+        id: sleepingSpy
+        target: box
+        signalName: "isSleepingChanged"
+    }
+
+    TestCase {
+        name: "Sleeping"
+        when: windowShown
+
+        function test_sleep_and_wake() {
+            compare(box.isSleeping, false)
+
+            // Falls onto the floor and goes to sleep there
+            tryVerify(() => box.isSleeping, 10000)
+            compare(sleepingSpy.count, 1)
+            verify(Math.abs(box.position.y - 50) < 1)
+
+            // An impulse wakes the body up, and it falls asleep again after landing
+            box.applyCentralImpulse(Qt.vector3d(0, 500, 0))
+            tryVerify(() => !box.isSleeping, 2000)
+            compare(sleepingSpy.count, 2)
+            tryVerify(() => box.position.y > 60, 2000)
+            tryVerify(() => box.isSleeping, 10000)
+            compare(sleepingSpy.count, 3)
+            verify(Math.abs(box.position.y - 50) < 1)
+        }
+    }
+}
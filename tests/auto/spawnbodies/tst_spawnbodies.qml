@@ -0,0 +1,190 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+import QtTest
+import QtQuick3D
+import QtQuick3D.Physics
+import QtQuick
+
+Item {
+    width: 640
+    height: 480
+    visible: true
+
+    PhysicsWorld {
+        id: world
+        running: true
+        forceDebugDraw: true
+        minimumTimestep: 15
+        maximumTimestep: 15
+        scene: viewport.scene
+    }
+
+    View3D {
+        id: viewport
+        anchors.fill: parent
+
+        environment: SceneEnvironment {
+            clearColor: "#d6dbdf"
+            backgroundMode: SceneEnvironment.Color
+        }
+
+        PerspectiveCamera {
+            position: Qt.vector3d(0, 200, 900)
+            eulerRotation: Qt.vector3d(-15, 0, 0)
+            clipFar: 5000
+            clipNear: 1
+        }
+
+        DirectionalLight {
+            eulerRotation.x: -45
+            eulerRotation.y: 45
+        }
+
+        StaticRigidBody {
+            position: Qt.vector3d(0, -50, 0)
+            collisionShapes: BoxShape {
+                scale: Qt.vector3d(20, 1, 20)
+            }
+            Model {
+                source: "#Cube"
+                scale: Qt.vector3d(20, 1, 20)
+                materials: DefaultMaterial {
+                    diffuseColor: "green"
+                }
+            }
+        }
+
+        // Disabled, so it only serves as a template. It claims to be sleeping to check that the
+        // spawned bodies do not copy that.
+        DynamicRigidBody {
+            id: templateBody
+            position: Qt.vector3d(0, 1000, 0)
+            simulationEnabled: false
+            isSleeping: true
+            massMode: DynamicRigidBody.Mass
+            mass: 3
+            collisionShapes: BoxShape {
+                id: templateShape
+            }
+        }
+
+        DynamicRigidBody {
+            id: floatingTemplate
+            position: Qt.vector3d(0, 1000, 0)
+            simulationEnabled: false
+            gravityEnabled: false
+            collisionShapes: SphereShape {}
+        }
+
+        Node {
+            id: container
+            position: Qt.vector3d(300, 0, 0)
+        }
+    }
+
+    TestCase {
+        name: "SpawnBodies"
+        when: windowShown
+
+        function fuzzyCompareVector(actual, expected) {
+            fuzzyCompare(actual.x, expected.x, 1)
+            fuzzyCompare(actual.y, expected.y, 1)
+            fuzzyCompare(actual.z, expected.z, 1)
+        }
+
+        function destroyAll(bodies) {
+            for (let body of bodies)
+                body.destroy()
+            wait(50)
+        }
+
+        function test_count_and_properties() {
+            const positions = [Qt.vector3d(-200, 200, 0), Qt.vector3d(0, 200, 0),
+                               Qt.vector3d(200, 200, 0)]
+            const bodies = world.spawnBodies(templateBody, positions, [], null)
+            compare(bodies.length, 3)
+
+            for (let i = 0; i < bodies.length; i++) {
+                const body = bodies[i]
+                compare(body.parent, templateBody.parent)
+                fuzzyCompareVector(body.position, positions[i])
+                compare(body.simulationEnabled, true)
+                compare(body.isSleeping, false)
+                compare(body.massMode, DynamicRigidBody.Mass)
+                compare(body.mass, 3)
+            }
+
+            // The template stays where it is, the spawned bodies fall onto the floor
+            for (let body of bodies)
+                tryVerify(() => Math.abs(body.position.y - 50) < 1, 5000)
+            fuzzyCompareVector(templateBody.position, Qt.vector3d(0, 1000, 0))
+
+            destroyAll(bodies)
+        }
+
+        function test_velocities() {
+            const positions = [Qt.vector3d(-100, 300, 0), Qt.vector3d(100, 300, 0)]
+            const velocities = [Qt.vector3d(-200, 0, 0), Qt.vector3d(200, 0, 0)]
+            const bodies = world.spawnBodies(floatingTemplate, positions, velocities, null)
+            compare(bodies.length, 2)
+
+            // Without gravity the bodies keep moving apart at a constant height
+            tryVerify(() => bodies[0].position.x < -200, 5000)
+            tryVerify(() => bodies[1].position.x > 200, 5000)
+            fuzzyCompare(bodies[0].position.y, 300, 1)
+            fuzzyCompare(bodies[1].position.y, 300, 1)
+
+            destroyAll(bodies)
+
+            // One velocity per position or none at all
+            ignoreWarning("PhysicsWorld: spawnBodies needs one linear velocity per position")
+            compare(world.spawnBodies(floatingTemplate, positions, [Qt.vector3d(1, 0, 0)], null)
+                            .length,
+                    0)
+        }
+
+        function test_parent_space() {
+            const bodies = world.spawnBodies(templateBody, [Qt.vector3d(0, 200, 100)], [],
+                                             container)
+            compare(bodies.length, 1)
+            const body = bodies[0]
+            compare(body.parent, container)
+            fuzzyCompareVector(body.position, Qt.vector3d(0, 200, 100))
+            fuzzyCompareVector(body.scenePosition, Qt.vector3d(300, 200, 100))
+
+            tryVerify(() => Math.abs(body.scenePosition.y - 50) < 1, 5000)
+            fuzzyCompare(body.scenePosition.x, 300, 1)
+
+            destroyAll(bodies)
+        }
+
+        function test_shared_shapes() {
+            const bodies = world.spawnBodies(templateBody, [Qt.vector3d(-100, 200, 0),
+                                                            Qt.vector3d(100, 200, 0)], [], null)
+            compare(bodies.length, 2)
+            for (let body of bodies) {
+                compare(body.collisionShapes.length, 1)
+                compare(body.collisionShapes[0], templateShape)
+            }
+
+            // The shapes still belong to the template, so destroying a spawned body neither
+            // destroys them nor affects the other bodies that use them
+            bodies[0].destroy()
+            wait(50)
+            compare(templateBody.collisionShapes.length, 1)
+            compare(templateBody.collisionShapes[0], templateShape)
+            tryVerify(() => Math.abs(bodies[1].position.y - 50) < 1, 5000)
+
+            bodies[1].destroy()
+            wait(50)
+            compare(templateBody.collisionShapes[0], templateShape)
+
+            // The template can still be used afterwards
+            const more = world.spawnBodies(templateBody, [Qt.vector3d(0, 200, -100)], [], null)
+            compare(more.length, 1)
+            tryVerify(() => Math.abs(more[0].position.y - 50) < 1, 5000)
+            destroyAll(more)
+        }
+    }
+}
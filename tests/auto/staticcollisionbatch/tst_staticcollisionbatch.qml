@@ -0,0 +1,114 @@
+// Copyright (C) 2025 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+import QtTest
+import QtQuick3D
+import QtQuick3D.Physics
+import QtQuick
+
+Item {
+    width: 640
+    height: 480
+    visible: true
+
+    PhysicsWorld {
+        id: world
+        gravity: Qt.vector3d(0, -9.81, 0)
+        running: true
+        forceDebugDraw: true
+        typicalLength: 1
+        typicalSpeed: 10
+        minimumTimestep: 16.6667
+        maximumTimestep: 16.6667
+        scene: viewport.scene
+        property real elapsedTime: 0
+    }
+
+    Connections {
+        target: world
+        function onFrameDone(timeStep) {
+            world.elapsedTime += timeStep
+        }
+    }
+
+    View3D {
+        id: viewport
+        anchors.fill: parent
+
+        environment: SceneEnvironment {
+            clearColor: "#151a3f"
+            backgroundMode: SceneEnvironment.Color
+        }
+
+        PerspectiveCamera {
+            position: Qt.vector3d(15, 10, 40)
+            eulerRotation: Qt.vector3d(-15, 0, 0)
+            clipFar: 200
+            clipNear: 0.1
+        }
+
+        DirectionalLight {
+            eulerRotation.x: -45
+            eulerRotation.y: 45
+        }
+
+        StaticCollisionBatch {
+            id: batch
+            sendContactReports: true
+
+            Node {
+                y: 2
+
+                // Top face ends up at y = 0
+                StaticRigidBody {
+                    position: Qt.vector3d(0, -3, 0)
+                    collisionShapes: BoxShape {
+                        extents: Qt.vector3d(20, 2, 20)
+                    }
+                }
+
+                // The body scale is baked into the box, top face ends up at y = 0
+                StaticRigidBody {
+                    position: Qt.vector3d(30, -3, 0)
+                    scale: Qt.vector3d(2, 2, 2)
+                    collisionShapes: BoxShape {
+                        extents: Qt.vector3d(5, 1, 5)
+                    }
+                }
+            }
+        }
+
+        DynamicRigidBody {
+            id: sphereLeft
+            position: Qt.vector3d(0, 5, 0)
+            receiveContactReports: true
+            property bool hit: false
+            onBodyContact: (body) => {
+                if (body === batch)
+                    sphereLeft.hit = true
+            }
+            collisionShapes: SphereShape {
+                diameter: 2
+            }
+        }
+
+        DynamicRigidBody {
+            id: sphereRight
+            position: Qt.vector3d(30, 5, 0)
+            collisionShapes: SphereShape {
+                diameter: 2
+            }
+        }
+    }
+
+    TestCase {
+        name: "StaticCollisionBatch"
+        when: world.elapsedTime > 3000
+
+        function test_restOnBakedBoxes() {
+            verify(sphereLeft.hit)
+            fuzzyCompare(sphereLeft.position.y, 1, 0.1)
+            fuzzyCompare(sphereRight.position.y, 1, 0.1)
+        }
+    }
+}
@@ -5,9 +5,20 @@
 
 #include <QtQuick3DUtils/private/qssgmesh_p.h>
 #include <QtQuick3DPhysics/private/qcacheutils_p.h>
-
+#include <QtQuick3DPhysics/private/qcollisionassets_p.h>
+#include <QtQuick3DPhysics/private/qmeshdecimation_p.h>
+
+#include <QtCore/QBuffer>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDir>
+#include <QtCore/QDirIterator>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
+#include <QtCore/QMutex>
+#include <QtCore/QSaveFile>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
 #include <QtGui/QImage>
 #include <QCommandLineParser>
 #include <QScopeGuard>
@@ -15,31 +26,140 @@
 #include "PxPhysicsAPI.h"
 #include "cooking/PxCooking.h"
 
+#include <algorithm>
 #include <iostream>
 
-bool tryReadMesh(QFile *file, QSSGMesh::Mesh &mesh)
+enum class OutputKind { Triangle, Convex, HeightField };
+
+struct CookInput
+{
+    QString inputPath;
+    // Output path without the .cooked.{tri,cvx,hf} suffix
+    QString outputBase;
+};
+
+struct CookedOutput
+{
+    OutputKind kind;
+    QString path;
+    QByteArray hash;
+    qint64 bytes = 0;
+    int triangles = -1;
+    int hullVertices = -1;
+    bool upToDate = false;
+};
+
+struct CookResult
+{
+    QList<CookedOutput> outputs;
+    QString error;
+    qint64 cookTimeMs = 0;
+};
+
+struct CookContext
+{
+    physx::PxCooking *cooking = nullptr;
+    // Only used to read back the cooked data for the report, creating objects is serialized
+    physx::PxPhysics *physics = nullptr;
+    QMutex physicsMutex;
+    bool cookTriangles = true;
+    bool cookConvex = true;
+    bool force = false;
+    // How convex hulls are computed, matching the properties of ConvexMeshShape
+    physx::PxConvexFlags convexFlags = physx::PxConvexFlag::eCOMPUTE_CONVEX;
+    physx::PxU16 vertexLimit = 255;
+    physx::PxU16 quantizedCount = 255;
+    // How triangle meshes are simplified, matching the properties of TriangleMeshShape
+    int decimationTriangleCount = 0;
+    float decimationTolerance = 0.f;
+    // Content hashes of the outputs written by previous runs, keyed by output path
+    QHash<QString, QByteArray> stamps;
+};
+
+static const char *kindSuffix(OutputKind kind)
+{
+    switch (kind) {
+    case OutputKind::Triangle:
+        return ".cooked.tri";
+    case OutputKind::Convex:
+        return ".cooked.cvx";
+    case OutputKind::HeightField:
+        return ".cooked.hf";
+    }
+    Q_UNREACHABLE_RETURN("");
+}
+
+static const char *kindName(OutputKind kind)
+{
+    switch (kind) {
+    case OutputKind::Triangle:
+        return "tri";
+    case OutputKind::Convex:
+        return "cvx";
+    case OutputKind::HeightField:
+        return "hf";
+    }
+    Q_UNREACHABLE_RETURN("");
+}
+
+// The hash covers everything that affects the cooked output
+static QByteArray outputHash(const QByteArray &inputData, OutputKind kind,
+                             const CookContext &context)
+{
+    const physx::PxCookingParams &params = context.cooking->getParams();
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(inputData);
+    hash.addData(QByteArrayView(kindName(kind)));
+    hash.addData(QByteArray::number(PX_PHYSICS_VERSION));
+    hash.addData(QByteArray::number(params.midphaseDesc.getType()));
+    if (params.midphaseDesc.getType() == physx::PxMeshMidPhase::eBVH34)
+        hash.addData(QByteArray::number(params.midphaseDesc.mBVH34Desc.numPrimsPerLeaf));
+    hash.addData(QByteArray::number(params.meshWeldTolerance));
+    hash.addData(QByteArray::number(quint32(params.meshPreprocessParams)));
+    if (kind == OutputKind::Convex) {
+        hash.addData(QByteArray::number(quint32(context.convexFlags)));
+        hash.addData(QByteArray::number(context.vertexLimit));
+        hash.addData(QByteArray::number(context.quantizedCount));
+    }
+    if (kind == OutputKind::Triangle) {
+        hash.addData(QByteArray::number(context.decimationTriangleCount));
+        hash.addData(QByteArray::number(context.decimationTolerance));
+    }
+    hash.addData(QCoreApplication::applicationVersion().toUtf8());
+    return hash.result().toHex();
+}
+
+static bool writeOutput(CookedOutput &output, physx::PxDefaultMemoryOutputStream &buf, QString &error)
 {
-    auto device = QSharedPointer<QIODevice>(file);
-    const quint32 id = 1;
-    mesh = QSSGMesh::Mesh::loadMesh(device.data(), id);
-    return mesh.isValid();
+    QDir().mkpath(QFileInfo(output.path).absolutePath());
+    QFile outputFile(output.path);
+    if (!outputFile.open(QIODevice::WriteOnly)) {
+        error = QStringLiteral("could not open '%1' for writing").arg(output.path);
+        return false;
+    }
+
+    outputFile.write(reinterpret_cast<char *>(buf.getData()), buf.getSize());
+    output.bytes = buf.getSize();
+    return true;
 }
 
-bool tryReadImage(const QString &inputPath, QImage &image)
+static bool isUpToDate(const CookedOutput &output, CookContext &context)
 {
-    image = QImage(inputPath);
-    return image.format() != QImage::Format_Invalid;
+    return !context.force && QFileInfo::exists(output.path)
+            && context.stamps.value(QDir::cleanPath(output.path)) == output.hash;
 }
 
-bool cookMeshes(const QString &inputPath, QSSGMesh::Mesh &mesh, physx::PxCooking *cooking)
+bool cookMeshes(const QString &inputPath, QSSGMesh::Mesh &mesh, CookContext &context,
+                QList<CookedOutput> &outputs, QString &error)
 {
-    Q_ASSERT(cooking);
+    Q_ASSERT(context.cooking);
 
     const int vStride = mesh.vertexBuffer().stride;
     const int vCount = mesh.vertexBuffer().data.size() / vStride;
     const auto *vd = mesh.vertexBuffer().data.constData();
 
-    const int iStride = mesh.indexBuffer().componentType == QSSGMesh::Mesh::ComponentType::UnsignedInt16 ? 2 : 4;
+    const bool u16Indices = mesh.indexBuffer().componentType == QSSGMesh::Mesh::ComponentType::UnsignedInt16;
+    const int iStride = u16Indices ? 2 : 4;
     const int iCount = mesh.indexBuffer().data.size() / iStride;
 
     int m_posOffset = 0;
@@ -50,127 +170,404 @@ bool cookMeshes(const QString &inputPath, QSSGMesh::Mesh &mesh, physx::PxCooking
             m_posOffset = v.offset;
     }
 
-    { // Triangle mesh
-        physx::PxTriangleMeshCookingResult::Enum result;
-        physx::PxTriangleMeshDesc triangleDesc;
-        triangleDesc.points.count = vCount;
-        triangleDesc.points.stride = vStride;
-        triangleDesc.points.data = vd + m_posOffset;
-
-        triangleDesc.flags = {}; //??? physx::PxMeshFlag::eFLIPNORMALS or
-                                 // physx::PxMeshFlag::e16_BIT_INDICES
-        triangleDesc.triangles.count = iCount / 3;
-        triangleDesc.triangles.stride = iStride * 3;
-        triangleDesc.triangles.data = mesh.indexBuffer().data.constData();
+    for (auto &output : outputs) {
+        if (output.upToDate)
+            continue;
 
         physx::PxDefaultMemoryOutputStream buf;
-        if (!cooking->cookTriangleMesh(triangleDesc, buf, &result)) {
-            std::cerr << "Error: could not cook triangle mesh '" << inputPath.toStdString() << "'." << std::endl;
-            return false;
+
+        if (output.kind == OutputKind::Triangle) {
+            physx::PxTriangleMeshCookingResult::Enum result;
+            physx::PxTriangleMeshDesc triangleDesc;
+            triangleDesc.points.count = vCount;
+            triangleDesc.points.stride = vStride;
+            triangleDesc.points.data = vd + m_posOffset;
+
+            if (u16Indices)
+                triangleDesc.flags.set(physx::PxMeshFlag::e16_BIT_INDICES);
+            triangleDesc.triangles.count = iCount / 3;
+            triangleDesc.triangles.stride = iStride * 3;
+            triangleDesc.triangles.data = mesh.indexBuffer().data.constData();
+
+            QList<QVector3D> vertices;
+            QList<quint32> indices;
+            if (context.decimationTriangleCount > 0 || context.decimationTolerance > 0.f) {
+                for (int i = 0; i < vCount; ++i)
+                    vertices.append(*reinterpret_cast<const QVector3D *>(vd + vStride * i + m_posOffset));
+                const auto *id = mesh.indexBuffer().data.constData();
+                for (int i = 0; i < iCount; ++i) {
+                    indices.append(u16Indices ? reinterpret_cast<const quint16 *>(id)[i]
+                                              : reinterpret_cast<const quint32 *>(id)[i]);
+                }
+                QMeshDecimation::simplify(vertices, indices, context.decimationTriangleCount,
+                                          context.decimationTolerance);
+
+                triangleDesc.points.count = vertices.size();
+                triangleDesc.points.stride = sizeof(QVector3D);
+                triangleDesc.points.data = vertices.constData();
+                triangleDesc.flags.clear(physx::PxMeshFlag::e16_BIT_INDICES);
+                triangleDesc.triangles.count = indices.size() / 3;
+                triangleDesc.triangles.stride = sizeof(quint32) * 3;
+                triangleDesc.triangles.data = indices.constData();
+            }
+
+            if (!context.cooking->cookTriangleMesh(triangleDesc, buf, &result)) {
+                error = QStringLiteral("could not cook triangle mesh '%1'").arg(inputPath);
+                return false;
+            }
+
+            QMutexLocker locker(&context.physicsMutex);
+            physx::PxDefaultMemoryInputData input(buf.getData(), buf.getSize());
+            if (auto *triangleMesh = context.physics->createTriangleMesh(input)) {
+                output.triangles = triangleMesh->getNbTriangles();
+                triangleMesh->release();
+            }
+        } else {
+            physx::PxConvexMeshCookingResult::Enum result;
+            QVector<physx::PxVec3> verts;
+
+            for (int i = 0; i < vCount; ++i) {
+                auto *vp = reinterpret_cast<const QVector3D *>(vd + vStride * i + m_posOffset);
+                verts << physx::PxVec3 { vp->x(), vp->y(), vp->z() };
+            }
+
+            const auto *convexVerts = verts.constData();
+
+            physx::PxConvexMeshDesc convexDesc;
+            convexDesc.points.count = vCount;
+            convexDesc.points.stride = sizeof(physx::PxVec3);
+            convexDesc.points.data = convexVerts;
+            convexDesc.flags = context.convexFlags;
+            convexDesc.vertexLimit = context.vertexLimit;
+            convexDesc.quantizedCount = context.quantizedCount;
+
+            if (!context.cooking->cookConvexMesh(convexDesc, buf, &result)) {
+                error = QStringLiteral("could not cook convex mesh '%1'").arg(inputPath);
+                return false;
+            }
+
+            QMutexLocker locker(&context.physicsMutex);
+            physx::PxDefaultMemoryInputData input(buf.getData(), buf.getSize());
+            if (auto *convexMesh = context.physics->createConvexMesh(input)) {
+                output.hullVertices = convexMesh->getNbVertices();
+                output.triangles = 0;
+                physx::PxHullPolygon polygon;
+                for (physx::PxU32 i = 0; i < convexMesh->getNbPolygons(); i++) {
+                    convexMesh->getPolygonData(i, polygon);
+                    output.triangles += polygon.mNbVerts - 2;
+                }
+                convexMesh->release();
+            }
         }
 
-        auto size = buf.getSize();
-        auto *data = buf.getData();
-        physx::PxDefaultMemoryInputData input(data, size);
+        if (!writeOutput(output, buf, error))
+            return false;
+    }
 
-        QString output = QFileInfo(inputPath).baseName() + QString(".cooked.tri");
-        auto outputFile = QFile(output);
+    return true;
+}
 
-        if (!outputFile.open(QIODevice::WriteOnly)) {
-            std::cerr << "Error: could not open '" << output.toStdString() << "' for writing." << std::endl;
-            return false;
+bool cookHeightfield(const QString &inputPath, QImage &heightMap, CookContext &context,
+                     CookedOutput &output, QString &error)
+{
+    Q_ASSERT(context.cooking);
+
+    int numRows = heightMap.height();
+    int numCols = heightMap.width();
+
+    auto samples = reinterpret_cast<physx::PxHeightFieldSample *>(malloc(sizeof(physx::PxHeightFieldSample) * (numRows * numCols)));
+    auto freeSamples = qScopeGuard([samples] { free(samples); });
+    for (int i = 0; i < numCols; i++) {
+        for (int j = 0; j < numRows; j++) {
+            float f = heightMap.pixelColor(i, j).valueF() - 0.5;
+            samples[i * numRows + j] = { qint16(0xffff * f), 0, 0 };
         }
+    }
 
-        outputFile.write(reinterpret_cast<char *>(buf.getData()), buf.getSize());
-        outputFile.close();
+    physx::PxHeightFieldDesc hfDesc;
+    hfDesc.format = physx::PxHeightFieldFormat::eS16_TM;
+    hfDesc.nbColumns = numRows;
+    hfDesc.nbRows = numCols;
+    hfDesc.samples.data = samples;
+    hfDesc.samples.stride = sizeof(physx::PxHeightFieldSample);
 
-        std::cout << "Success: wrote triangle mesh '" << output.toStdString() << "'." << std::endl;
+    physx::PxDefaultMemoryOutputStream buf;
+    if (!(numRows && numCols && context.cooking->cookHeightField(hfDesc, buf))) {
+        error = QStringLiteral("could not create height field from '%1'").arg(inputPath);
+        return false;
     }
 
-    { // Convex mesh
-        physx::PxConvexMeshCookingResult::Enum result;
-        QVector<physx::PxVec3> verts;
+    output.triangles = 2 * (numRows - 1) * (numCols - 1);
+    return writeOutput(output, buf, error);
+}
 
-        for (int i = 0; i < vCount; ++i) {
-            auto *vp = reinterpret_cast<const QVector3D *>(vd + vStride * i + m_posOffset);
-            verts << physx::PxVec3 { vp->x(), vp->y(), vp->z() };
+static CookResult cookInput(const CookInput &input, CookContext &context)
+{
+    CookResult result;
+    QElapsedTimer timer;
+    timer.start();
+    auto recordTime = qScopeGuard([&] { result.cookTimeMs = timer.elapsed(); });
+
+    QFile file(input.inputPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        result.error = QStringLiteral("could not open input file '%1'").arg(input.inputPath);
+        return result;
+    }
+    const QByteArray data = file.readAll();
+
+    const auto addOutput = [&](OutputKind kind) {
+        CookedOutput output { kind, input.outputBase + QLatin1StringView(kindSuffix(kind)),
+                              outputHash(data, kind, context) };
+        output.upToDate = isUpToDate(output, context);
+        if (output.upToDate)
+            output.bytes = QFileInfo(output.path).size();
+        result.outputs.append(output);
+    };
+
+    QImage image;
+    QSSGMesh::Mesh mesh;
+    if (image.loadFromData(data)) {
+        addOutput(OutputKind::HeightField);
+        if (!result.outputs.first().upToDate
+            && !cookHeightfield(input.inputPath, image, context, result.outputs.first(), result.error))
+            return result;
+    } else {
+        if (context.cookTriangles)
+            addOutput(OutputKind::Triangle);
+        if (context.cookConvex)
+            addOutput(OutputKind::Convex);
+
+        if (std::all_of(result.outputs.cbegin(), result.outputs.cend(),
+                        [](const CookedOutput &output) { return output.upToDate; }))
+            return result;
+
+        QBuffer buffer;
+        buffer.setData(data);
+        buffer.open(QIODevice::ReadOnly);
+        const quint32 id = 1;
+        mesh = QSSGMesh::Mesh::loadMesh(&buffer, id);
+        if (!mesh.isValid()) {
+            result.error = QStringLiteral("failed to read mesh or image from file '%1'").arg(input.inputPath);
+            return result;
         }
+        if (!cookMeshes(input.inputPath, mesh, context, result.outputs, result.error))
+            return result;
+    }
 
-        const auto *convexVerts = verts.constData();
+    return result;
+}
 
-        physx::PxConvexMeshDesc convexDesc;
-        convexDesc.points.count = vCount;
-        convexDesc.points.stride = sizeof(physx::PxVec3);
-        convexDesc.points.data = convexVerts;
-        convexDesc.flags = physx::PxConvexFlag::eCOMPUTE_CONVEX;
+static bool isMeshFile(const QString &path)
+{
+    return path.endsWith(QLatin1StringView(".mesh"), Qt::CaseInsensitive);
+}
 
-        physx::PxDefaultMemoryOutputStream buf;
-        if (!cooking->cookConvexMesh(convexDesc, buf, &result)) {
-            std::cerr << "Error: could not cook convex mesh '" << inputPath.toStdString() << "'." << std::endl;
-            return false;
+// Directories are searched recursively for .mesh files and the directory structure is kept in
+// the output directory. Files given directly or through a manifest are written to the output
+// directory itself, see checkOutputsUnique().
+static bool collectInputs(const QString &path, const QDir &outputDir, QList<CookInput> &inputs)
+{
+    const QFileInfo info(path);
+    if (info.isDir()) {
+        const QDir root(path);
+        QDirIterator it(path, QDir::Files, QDirIterator::Subdirectories);
+        QStringList files;
+        while (it.hasNext()) {
+            const QString file = it.next();
+            if (isMeshFile(file))
+                files.append(file);
+        }
+        files.sort();
+        for (const QString &file : std::as_const(files)) {
+            const QFileInfo fileInfo(file);
+            const QString relativeDir = root.relativeFilePath(fileInfo.absolutePath());
+            inputs.append({ file,
+                            QDir::cleanPath(outputDir.filePath(relativeDir) + QLatin1Char('/')
+                                            + fileInfo.baseName()) });
         }
+        return true;
+    }
 
-        auto size = buf.getSize();
-        auto *data = buf.getData();
-        physx::PxDefaultMemoryInputData input(data, size);
+    if (!info.exists()) {
+        std::cerr << "Error: could not open input file '" << path.toStdString() << "'" << std::endl;
+        return false;
+    }
 
-        QString output = QFileInfo(inputPath).baseName() + QString(".cooked.cvx");
-        auto outputFile = QFile(output);
+    inputs.append({ path, outputDir.filePath(info.baseName()) });
+    return true;
+}
 
-        if (!outputFile.open(QIODevice::WriteOnly)) {
-            std::cerr << "Error: could not open '" << output.toStdString() << "' for writing." << std::endl;
+// A manifest lists one input file or directory per line, relative to the manifest. Empty lines
+// and lines starting with '#' are ignored.
+static bool readManifest(const QString &manifestPath, const QDir &outputDir, QList<CookInput> &inputs)
+{
+    QFile manifest(manifestPath);
+    if (!manifest.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        std::cerr << "Error: could not open manifest '" << manifestPath.toStdString() << "'" << std::endl;
+        return false;
+    }
+
+    const QDir manifestDir = QFileInfo(manifestPath).absoluteDir();
+    while (!manifest.atEnd()) {
+        const QString line = QString::fromUtf8(manifest.readLine()).trimmed();
+        if (line.isEmpty() || line.startsWith(QLatin1Char('#')))
+            continue;
+        if (!collectInputs(manifestDir.filePath(line), outputDir, inputs))
             return false;
+    }
+    return true;
+}
+
+// Files given directly or through a manifest are flattened into the output directory, so two
+// inputs with the same base name would overwrite each other's outputs.
+static bool checkOutputsUnique(const QList<CookInput> &inputs)
+{
+    QHash<QString, QString> inputByOutput;
+    bool unique = true;
+    for (const CookInput &input : inputs) {
+        const QString output = QDir::cleanPath(input.outputBase);
+        const auto it = inputByOutput.constFind(output);
+        if (it == inputByOutput.constEnd()) {
+            inputByOutput.insert(output, input.inputPath);
+            continue;
         }
+        std::cerr << "Error: inputs '" << it->toStdString() << "' and '"
+                  << input.inputPath.toStdString() << "' are both cooked to '"
+                  << output.toStdString()
+                  << "', rename one of them or pass their directory instead" << std::endl;
+        unique = false;
+    }
+    return unique;
+}
 
-        outputFile.write(reinterpret_cast<char *>(buf.getData()), buf.getSize());
-        outputFile.close();
+static const char *stampsFileName = "cooker.stamps";
 
-        std::cout << "Success: wrote convex mesh '" << output.toStdString() << "'." << std::endl;
+static QHash<QString, QByteArray> readStamps(const QDir &outputDir)
+{
+    QHash<QString, QByteArray> stamps;
+    QFile file(outputDir.filePath(QLatin1StringView(stampsFileName)));
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return stamps;
+
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine().trimmed();
+        const qsizetype separator = line.indexOf(' ');
+        if (separator > 0) {
+            const QString output = QString::fromUtf8(line.mid(separator + 1));
+            stamps.insert(QDir::cleanPath(outputDir.filePath(output)), line.left(separator));
+        }
     }
+    return stamps;
+}
 
-    return true;
+static void writeStamps(const QDir &outputDir, const QHash<QString, QByteArray> &stamps)
+{
+    QFile file(outputDir.filePath(QLatin1StringView(stampsFileName)));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        std::cerr << "Warning: could not write '" << file.fileName().toStdString() << "'" << std::endl;
+        return;
+    }
+
+    QStringList outputs = stamps.keys();
+    outputs.sort();
+    for (const QString &output : std::as_const(outputs))
+        file.write(stamps.value(output) + ' ' + outputDir.relativeFilePath(output).toUtf8() + '\n');
 }
 
-bool cookHeightfield(const QString &inputPath, QImage &heightMap, physx::PxCooking *cooking)
+static QCollisionAssets::Kind assetKind(OutputKind kind)
 {
-    Q_ASSERT(cooking);
+    switch (kind) {
+    case OutputKind::Triangle:
+        return QCollisionAssets::Kind::TriangleMesh;
+    case OutputKind::Convex:
+        return QCollisionAssets::Kind::ConvexMesh;
+    case OutputKind::HeightField:
+        return QCollisionAssets::Kind::HeightField;
+    }
+    Q_UNREACHABLE_RETURN(QCollisionAssets::Kind::TriangleMesh);
+}
 
-    int numRows = heightMap.height();
-    int numCols = heightMap.width();
+// Packs the cooked outputs into one collision asset collection. The inputs become the assets,
+// numbered from 1 in input order.
+static bool writeCollection(const QString &collectionPath, const QList<CookInput> &inputs,
+                            const QList<CookResult> &results, physx::PxPhysics &physics)
+{
+    physx::PxSerializationRegistry *registry =
+            physx::PxSerialization::createSerializationRegistry(physics);
+    physx::PxCollection *collection = PxCreateCollection();
+    QList<physx::PxBase *> objects;
+    auto cleanup = qScopeGuard([&] {
+        collection->release();
+        for (auto *object : std::as_const(objects))
+            object->release();
+        registry->release();
+    });
 
-    auto samples = reinterpret_cast<physx::PxHeightFieldSample *>(malloc(sizeof(physx::PxHeightFieldSample) * (numRows * numCols)));
-    for (int i = 0; i < numCols; i++) {
-        for (int j = 0; j < numRows; j++) {
-            float f = heightMap.pixelColor(i, j).valueF() - 0.5;
-            samples[i * numRows + j] = { qint16(0xffff * f), 0, 0 };
+    for (qsizetype i = 0; i < results.size(); ++i) {
+        for (const CookedOutput &output : results[i].outputs) {
+            QFile file(output.path);
+            if (!file.open(QIODevice::ReadOnly)) {
+                std::cerr << "Error: could not open '" << output.path.toStdString() << "'" << std::endl;
+                return false;
+            }
+            QByteArray data = file.readAll();
+            physx::PxDefaultMemoryInputData input(reinterpret_cast<physx::PxU8 *>(data.data()),
+                                                  physx::PxU32(data.size()));
+            physx::PxBase *object = nullptr;
+            switch (output.kind) {
+            case OutputKind::Triangle:
+                object = physics.createTriangleMesh(input);
+                break;
+            case OutputKind::Convex:
+                object = physics.createConvexMesh(input);
+                break;
+            case OutputKind::HeightField:
+                object = physics.createHeightField(input);
+                break;
+            }
+            if (!object) {
+                std::cerr << "Error: could not read '" << output.path.toStdString() << "'" << std::endl;
+                return false;
+            }
+            objects.append(object);
+            collection->add(*object, QCollisionAssets::objectId(quint32(i + 1), assetKind(output.kind)));
         }
     }
 
-    physx::PxHeightFieldDesc hfDesc;
-    hfDesc.format = physx::PxHeightFieldFormat::eS16_TM;
-    hfDesc.nbColumns = numRows;
-    hfDesc.nbRows = numCols;
-    hfDesc.samples.data = samples;
-    hfDesc.samples.stride = sizeof(physx::PxHeightFieldSample);
-
     physx::PxDefaultMemoryOutputStream buf;
-    if (!(numRows && numCols && cooking->cookHeightField(hfDesc, buf))) {
-        std::cerr << "Could not create height field from '" << inputPath.toStdString() << "'." << std::endl;
+    if (!physx::PxSerialization::serializeCollectionToBinary(buf, *collection, *registry)) {
+        std::cerr << "Error: could not serialize the collection" << std::endl;
         return false;
     }
 
-    QString output = QFileInfo(inputPath).baseName() + QString(".cooked.hf");
-    auto outputFile = QFile(output);
-
-    if (!outputFile.open(QIODevice::WriteOnly)) {
-        std::cerr << "Could not open '" << output.toStdString() << "' for writing." << std::endl;
+    QCollisionAssets::Header header = {};
+    header.magic = QCollisionAssets::Magic;
+    header.version = QCollisionAssets::Version;
+    header.physxVersion = PX_PHYSICS_VERSION;
+    header.assetCount = quint32(inputs.size());
+    header.dataOffset = QCollisionAssets::DataAlignment;
+    header.dataSize = buf.getSize();
+    static_assert(sizeof(QCollisionAssets::Header) <= QCollisionAssets::DataAlignment);
+
+    QDir().mkpath(QFileInfo(collectionPath).absolutePath());
+    QSaveFile file(collectionPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        std::cerr << "Error: could not open '" << collectionPath.toStdString() << "' for writing" << std::endl;
+        return false;
+    }
+    QByteArray headerData(QCollisionAssets::DataAlignment, '\0');
+    memcpy(headerData.data(), &header, sizeof(header));
+    file.write(headerData);
+    file.write(reinterpret_cast<const char *>(buf.getData()), buf.getSize());
+    if (!file.commit()) {
+        std::cerr << "Error: could not write '" << collectionPath.toStdString() << "'" << std::endl;
         return false;
     }
 
-    outputFile.write(reinterpret_cast<char *>(buf.getData()), buf.getSize());
-    outputFile.close();
-    std::cout << "Success: wrote height field '" << output.toStdString() << "'" << std::endl;
-
+    std::cout << "Wrote " << objects.size() << " objects to " << collectionPath.toStdString()
+              << ":" << std::endl;
+    for (qsizetype i = 0; i < inputs.size(); ++i)
+        std::cout << "#" << i + 1 << '\t' << inputs[i].inputPath.toStdString() << std::endl;
     return true;
 }
 
@@ -186,46 +583,249 @@ int main(int argc, char *argv[])
     parser.addHelpOption();
     parser.addVersionOption();
     parser.addPositionalArgument("input",
-                                 "The input file(s). Accepts either a .mesh created by QtQuick3D's balsam"
-                                 " or a Qt compatible image file. The output filename will be of the format"
-                                 " input.cooked.{cvx/tri/hf}. The filename suffixes .cvx, .tri, and .hf"
-                                 " mean it is a convex mesh, a triangle mesh or a heightfield.");
+                                 "The input file(s) or directories. Accepts either a .mesh created by QtQuick3D's balsam"
+                                 " or a Qt compatible image file. Directories are searched recursively for .mesh files."
+                                 " The output filename will be of the format input.cooked.{cvx/tri/hf}. The filename"
+                                 " suffixes .cvx, .tri, and .hf mean it is a convex mesh, a triangle mesh or a heightfield.");
+
+    QCommandLineOption manifestOption({ "m", "manifest" },
+                                      "Read input files and directories from <file>, one per line.",
+                                      "file");
+    QCommandLineOption outputDirOption({ "o", "output-dir" },
+                                       "Write the cooked files to <dir> instead of the current directory.",
+                                       "dir");
+    QCommandLineOption typeOption({ "t", "type" },
+                                  "Cook meshes as <type>: triangle, convex or all. The default is all.",
+                                  "type", "all");
+    QCommandLineOption jobsOption({ "j", "jobs" },
+                                  "Cook <n> inputs in parallel. The default is the number of cores.",
+                                  "n");
+    QCommandLineOption forceOption({ "f", "force" },
+                                   "Cook all inputs, also the ones whose outputs are up to date.");
+    QCommandLineOption collectionOption({ "c", "collection" },
+                                        "Also pack all cooked outputs into the collision asset collection <file>."
+                                        " The inputs are used as the source <file>#<n>, numbered from 1 in input order.",
+                                        "file");
+    QCommandLineOption midphaseOption("midphase",
+                                      "Build triangle meshes with the <midphase> structure: bvh33 or bvh34."
+                                      " The default is bvh33.",
+                                      "midphase", "bvh33");
+    QCommandLineOption primsPerLeafOption("prims-per-leaf",
+                                          "Store at most <n> triangles per leaf of the bvh34 midphase,"
+                                          " between 4 and 15. The default is 4.",
+                                          "n", "4");
+    QCommandLineOption weldToleranceOption("weld-tolerance",
+                                           "Weld triangle mesh vertices closer than <distance>."
+                                           " The default is 0, meaning no welding.",
+                                           "distance", "0");
+    QCommandLineOption noCleanMeshOption("no-clean-mesh",
+                                         "Do not clean triangle meshes. The input meshes must already be clean.");
+    QCommandLineOption noActiveEdgesOption("no-active-edges",
+                                           "Do not precompute the active edges of triangle meshes.");
+    QCommandLineOption vertexLimitOption("vertex-limit",
+                                         "Limit convex hulls to <n> vertices, between 8 and 255, or 4 and"
+                                         " 255 with --plane-shifting. The default is 255.",
+                                         "n", "255");
+    QCommandLineOption quantizeOption("quantize",
+                                      "Reduce the input of convex hulls to <n> vertices by k-means"
+                                      " clustering. The default is 0, meaning no reduction.",
+                                      "n", "0");
+    QCommandLineOption shiftVerticesOption("shift-vertices",
+                                           "Center the vertices around the origin before computing convex hulls.");
+    QCommandLineOption planeShiftingOption("plane-shifting",
+                                           "Apply the convex hull vertex limit by shifting the planes of the hull.");
+    QCommandLineOption decimateTrianglesOption("decimate-triangles",
+                                               "Simplify triangle meshes to at most <n> triangles."
+                                               " The default is 0, meaning no limit.",
+                                               "n", "0");
+    QCommandLineOption decimateToleranceOption("decimate-tolerance",
+                                               "Simplify triangle meshes for as long as the surface moves"
+                                               " less than <distance>. The default is 0, meaning no limit.",
+                                               "distance", "0");
+    parser.addOptions({ manifestOption, outputDirOption, typeOption, jobsOption, forceOption,
+                        collectionOption, midphaseOption, primsPerLeafOption, weldToleranceOption,
+                        noCleanMeshOption, noActiveEdgesOption, vertexLimitOption, quantizeOption,
+                        shiftVerticesOption, planeShiftingOption, decimateTrianglesOption,
+                        decimateToleranceOption });
     parser.process(app);
 
     const QStringList args = parser.positionalArguments();
-    if (args.isEmpty())
+    const QStringList manifests = parser.values(manifestOption);
+    if (args.isEmpty() && manifests.isEmpty())
         parser.showHelp(0);
 
+    const QString type = parser.value(typeOption);
+    if (type != QLatin1StringView("all") && type != QLatin1StringView("triangle")
+        && type != QLatin1StringView("convex")) {
+        std::cerr << "Error: unknown type '" << type.toStdString() << "'" << std::endl;
+        return -1;
+    }
+
+    // Matches the cooking properties of PhysicsWorld
+    physx::PxCookingParams params((physx::PxTolerancesScale()));
+    const QString midphase = parser.value(midphaseOption);
+    if (midphase == QLatin1StringView("bvh34")) {
+        params.midphaseDesc = physx::PxMeshMidPhase::eBVH34;
+        params.midphaseDesc.mBVH34Desc.numPrimsPerLeaf = parser.value(primsPerLeafOption).toUInt();
+        if (!params.midphaseDesc.isValid()) {
+            std::cerr << "Error: the number of triangles per leaf must be between 4 and 15" << std::endl;
+            return -1;
+        }
+    } else if (midphase != QLatin1StringView("bvh33")) {
+        std::cerr << "Error: unknown midphase '" << midphase.toStdString() << "'" << std::endl;
+        return -1;
+    }
+
+    bool weldToleranceOk = false;
+    params.meshWeldTolerance = parser.value(weldToleranceOption).toFloat(&weldToleranceOk);
+    if (!weldToleranceOk || params.meshWeldTolerance < 0.f) {
+        std::cerr << "Error: invalid weld tolerance '"
+                  << parser.value(weldToleranceOption).toStdString() << "'" << std::endl;
+        return -1;
+    }
+    if (params.meshWeldTolerance > 0.f)
+        params.meshPreprocessParams |= physx::PxMeshPreprocessingFlag::eWELD_VERTICES;
+    if (parser.isSet(noCleanMeshOption))
+        params.meshPreprocessParams |= physx::PxMeshPreprocessingFlag::eDISABLE_CLEAN_MESH;
+    if (parser.isSet(noActiveEdgesOption))
+        params.meshPreprocessParams |= physx::PxMeshPreprocessingFlag::eDISABLE_ACTIVE_EDGES_PRECOMPUTE;
+
+    // Matches the hull properties of ConvexMeshShape
+    physx::PxConvexFlags convexFlags = physx::PxConvexFlag::eCOMPUTE_CONVEX;
+    const bool planeShifting = parser.isSet(planeShiftingOption);
+    if (planeShifting)
+        convexFlags |= physx::PxConvexFlag::ePLANE_SHIFTING;
+    if (parser.isSet(shiftVerticesOption))
+        convexFlags |= physx::PxConvexFlag::eSHIFT_VERTICES;
+
+    const int vertexLimit = parser.value(vertexLimitOption).toInt();
+    if (vertexLimit < (planeShifting ? 4 : 8) || vertexLimit > 255) {
+        std::cerr << "Error: invalid vertex limit '"
+                  << parser.value(vertexLimitOption).toStdString() << "'" << std::endl;
+        return -1;
+    }
+
+    const int quantizedCount = parser.value(quantizeOption).toInt();
+    if (quantizedCount != 0 && (quantizedCount < 4 || quantizedCount > 65535)) {
+        std::cerr << "Error: the quantized vertex count must be 0 or between 4 and 65535" << std::endl;
+        return -1;
+    }
+    if (quantizedCount > 0)
+        convexFlags |= physx::PxConvexFlag::eQUANTIZE_INPUT;
+
+    // Matches the decimation properties of TriangleMeshShape
+    bool decimationTriangleCountOk = false;
+    const int decimationTriangleCount =
+            parser.value(decimateTrianglesOption).toInt(&decimationTriangleCountOk);
+    if (!decimationTriangleCountOk || decimationTriangleCount < 0) {
+        std::cerr << "Error: invalid triangle count '"
+                  << parser.value(decimateTrianglesOption).toStdString() << "'" << std::endl;
+        return -1;
+    }
+
+    bool decimationToleranceOk = false;
+    const float decimationTolerance =
+            parser.value(decimateToleranceOption).toFloat(&decimationToleranceOk);
+    if (!decimationToleranceOk || decimationTolerance < 0.f) {
+        std::cerr << "Error: invalid decimation tolerance '"
+                  << parser.value(decimateToleranceOption).toStdString() << "'" << std::endl;
+        return -1;
+    }
+
+    const QDir outputDir(parser.isSet(outputDirOption) ? parser.value(outputDirOption)
+                                                       : QDir::currentPath());
+    if (!QDir().mkpath(outputDir.path())) {
+        std::cerr << "Error: could not create output directory '" << outputDir.path().toStdString() << "'" << std::endl;
+        return -1;
+    }
+
+    QList<CookInput> inputs;
+    for (const QString &manifest : manifests) {
+        if (!readManifest(manifest, outputDir, inputs))
+            return -1;
+    }
+    for (const QString &inputPath : args) {
+        if (!collectInputs(inputPath, outputDir, inputs))
+            return -1;
+    }
+    if (!checkOutputsUnique(inputs))
+        return -1;
+
     physx::PxDefaultErrorCallback defaultErrorCallback;
     physx::PxDefaultAllocator defaultAllocatorCallback;
     auto foundation = PxCreateFoundation(PX_PHYSICS_VERSION, defaultAllocatorCallback, defaultErrorCallback);
-    auto cooking = PxCreateCooking(PX_PHYSICS_VERSION, *foundation, physx::PxCookingParams(physx::PxTolerancesScale()));
+    auto cooking = PxCreateCooking(PX_PHYSICS_VERSION, *foundation, params);
+    auto physics = PxCreatePhysics(PX_PHYSICS_VERSION, *foundation, physx::PxTolerancesScale());
     auto cleanup = qScopeGuard([&] {
+        physics->release();
         cooking->release();
         foundation->release();
     });
 
-    for (const QString &inputPath : args) {
-        QFile *file = new QFile(inputPath);
-        if (!file->open(QIODevice::ReadOnly)) {
-            delete file;
-            std::cerr << "Error: could not open input file '" << inputPath.toStdString() << "'" << std::endl;
-            return -1;
+    CookContext context;
+    context.cooking = cooking;
+    context.physics = physics;
+    context.cookTriangles = type != QLatin1StringView("convex");
+    context.cookConvex = type != QLatin1StringView("triangle");
+    context.force = parser.isSet(forceOption);
+    context.convexFlags = convexFlags;
+    context.vertexLimit = physx::PxU16(vertexLimit);
+    if (quantizedCount > 0)
+        context.quantizedCount = physx::PxU16(quantizedCount);
+    context.decimationTriangleCount = decimationTriangleCount;
+    context.decimationTolerance = decimationTolerance;
+    context.stamps = readStamps(outputDir);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(parser.isSet(jobsOption) ? qMax(1, parser.value(jobsOption).toInt())
+                                                    : QThread::idealThreadCount());
+
+    QElapsedTimer totalTimer;
+    totalTimer.start();
+
+    QList<CookResult> results(inputs.size());
+    for (qsizetype i = 0; i < inputs.size(); ++i)
+        pool.start([&, i] { results[i] = cookInput(inputs[i], context); });
+    pool.waitForDone();
+
+    // Report in input order so the output is stable regardless of the number of jobs
+    int failed = 0;
+    int cooked = 0;
+    int skipped = 0;
+    std::cout << "status\tkind\ttriangles\thull vertices\tbytes\tcook time (ms)\toutput" << std::endl;
+    for (qsizetype i = 0; i < inputs.size(); ++i) {
+        const CookResult &result = results[i];
+        if (!result.error.isEmpty()) {
+            std::cerr << "Error: " << result.error.toStdString() << std::endl;
+            failed++;
+            continue;
         }
 
-        QImage image;
-        QSSGMesh::Mesh mesh;
-        if (tryReadImage(inputPath, image)) {
-            if (!cookHeightfield(inputPath, image, cooking))
-                return -1;
-        } else if (tryReadMesh(file, mesh)) {
-            if (!cookMeshes(inputPath, mesh, cooking))
-                return -1;
-        } else {
-            std::cerr << "Error: failed to read mesh or image from file '" << inputPath.toStdString() << "'" << std::endl;
-            return -1;
+        for (const CookedOutput &output : result.outputs) {
+            const auto count = [](int value) {
+                return value < 0 ? std::string("-") : std::to_string(value);
+            };
+            std::cout << (output.upToDate ? "skipped" : "cooked") << '\t' << kindName(output.kind)
+                      << '\t' << count(output.triangles) << '\t' << count(output.hullVertices)
+                      << '\t' << output.bytes << '\t' << (output.upToDate ? 0 : result.cookTimeMs)
+                      << '\t' << output.path.toStdString() << std::endl;
+            context.stamps.insert(QDir::cleanPath(output.path), output.hash);
+            if (output.upToDate)
+                skipped++;
+            else
+                cooked++;
         }
     }
 
-    return 0;
+    writeStamps(outputDir, context.stamps);
+
+    if (parser.isSet(collectionOption) && failed == 0
+        && !writeCollection(parser.value(collectionOption), inputs, results, *physics))
+        failed++;
+
+    std::cout << "Cooked " << cooked << ", skipped " << skipped << " up-to-date, " << failed
+              << " failed in " << totalTimer.elapsed() << " ms using " << pool.maxThreadCount()
+              << " threads." << std::endl;
+
+    return failed > 0 ? -1 : 0;
 }